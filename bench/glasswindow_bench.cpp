@@ -0,0 +1,836 @@
+// Headless benchmarks for the glasswindow plugin logic.
+//
+// Writes one JSON document to stdout:
+//   {"context": {...}, "benchmarks": [{"name", "iterations", "ns_per_op", "ops_per_sec", ...counters}]}
+// Progress goes to stderr, so `glasswindow_bench > bench.json` stays parseable.
+// A few behaviour checks run along the way; if one fails the exit code is 1.
+
+#include <HyprlandAPI.hpp>
+
+#include "backdropbatch.hpp"
+#include "backdropcache.hpp"
+#include "blur.hpp"
+#include "configsnapshot.hpp"
+#include "distortion.hpp"
+#include "framestats.hpp"
+#include "governor.hpp"
+#include "rulematcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <new>
+#include <random>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+void PLUGIN_INIT(HANDLE handle);
+void PLUGIN_EXIT();
+}
+
+// Counts heap allocations, for the allocs_per_op counters
+static uint64_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+// GCC sees the malloc/free pairing through inlined new/delete and warns
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    std::free(p);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    struct SResult {
+        std::string                                  name;
+        uint64_t                                     iterations = 0;
+        double                                       nsPerOp    = 0.0;
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    struct SOptions {
+        const char* filter  = nullptr;
+        double      minTime = 0.2; // seconds per benchmark
+    };
+
+    SOptions             g_options;
+    std::vector<SResult> g_results;
+    int                  g_failedChecks = 0;
+
+    void check(bool ok, const char* what) {
+        if (!ok) {
+            std::fprintf(stderr, "check failed: %s\n", what);
+            g_failedChecks++;
+        }
+    }
+
+    // Heap allocations per call of `fn`, after one warm-up call
+    template <typename F>
+    double allocationsPerCall(F&& fn, uint64_t calls = 64) {
+        fn();
+        const uint64_t before = g_allocations;
+        for (uint64_t i = 0; i < calls; ++i)
+            fn();
+        return static_cast<double>(g_allocations - before) / calls;
+    }
+
+    // Pulls "key": <number> out of the hyprctl JSON
+    long jsonNumber(const std::string& json, const std::string& key) {
+        const size_t at = json.find("\"" + key + "\": ");
+        return at == std::string::npos ? -1 : std::stol(json.substr(at + key.size() + 4));
+    }
+
+    // Keeps the optimizer from dropping benchmarked work
+    template <typename T>
+    void doNotOptimize(const T& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    bool selected(const std::string& name) {
+        return !g_options.filter || name.find(g_options.filter) != std::string::npos;
+    }
+
+    // Runs `fn` in growing batches until minTime has passed. `fn` performs
+    // `opsPerCall` operations per call, results are reported per operation.
+    template <typename F>
+    SResult* measure(const std::string& name, uint64_t opsPerCall, F&& fn) {
+        if (!selected(name))
+            return nullptr;
+
+        std::fprintf(stderr, "running %s\n", name.c_str());
+
+        uint64_t calls = 0;
+        uint64_t batch = 1;
+        auto     start = Clock::now();
+        double   elapsed = 0.0;
+
+        while (elapsed < g_options.minTime) {
+            for (uint64_t i = 0; i < batch; ++i)
+                fn();
+            calls += batch;
+            batch *= 2;
+            elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        const uint64_t ops = calls * opsPerCall;
+        g_results.push_back({name, ops, elapsed * 1e9 / ops, {}});
+        return &g_results.back();
+    }
+
+    // Synthetic window titles, deterministic so runs are comparable
+    std::vector<std::string> makeTitles(size_t count) {
+        static const char* apps[]  = {"kitty", "Alacritty", "foot", "Mozilla Firefox", "Visual Studio Code", "Discord", "Spotify", "Thunar", "Obsidian", "Steam"};
+        static const char* words[] = {"main.cpp", "README.md", "~/src/hyprland", "Inbox (12 unread)", "nvim", "cargo build", "Daily Notes", "Settings", "htop", "YouTube"};
+
+        std::mt19937             rng(1234);
+        std::vector<std::string> titles;
+        titles.reserve(count);
+
+        for (size_t i = 0; i < count; ++i) {
+            std::string title = words[rng() % std::size(words)];
+            title += " - ";
+            title += words[rng() % std::size(words)];
+            title += " — ";
+            title += apps[rng() % std::size(apps)];
+            titles.emplace_back(std::move(title));
+        }
+
+        return titles;
+    }
+
+    struct SRuleSet {
+        const char* name;
+        const char* rules;
+    };
+
+    const SRuleSet RULE_SETS[] = {
+        {"matchall", ".*"},
+        {"literal", "kitty;firefox;alacritty;foot;code;discord;spotify;thunar;obsidian;steam;slack;zoom;gimp;inkscape;blender;krita"},
+        {"anchored", "^kitty;^foot;Firefox$;^Visual Studio Code$;^htop;Steam$;^nvim;Discord$"},
+        {"regex", "term.*al;^(neo)?vim;fire(fox|dragon);[0-9]+ unread;.*\\.rs$;^~/src/[a-z]+;chat(gpt)?;music|spotify"},
+        {"mixed", "kitty;foot;^htop;Steam$;term.*al;fire(fox|dragon);[0-9]+ unread;.*\\.rs$"},
+    };
+
+    // matches() and firstMatch() against one std::regex per rule, tried in order
+    bool agreesWithRegexLoop(const std::string& rules, const std::vector<std::string>& titles) {
+        CRuleMatcher            matcher;
+        std::vector<std::regex> loop;
+        matcher.compile(rules);
+
+        size_t start = 0;
+        while (true) {
+            const size_t end = rules.find(';', start);
+            loop.emplace_back(rules.substr(start, end - start), std::regex::ECMAScript | std::regex::icase);
+            if (end == std::string::npos)
+                break;
+            start = end + 1;
+        }
+
+        for (const auto& title : titles) {
+            int expected = -1;
+            for (size_t i = 0; i < loop.size() && expected < 0; ++i)
+                expected = std::regex_search(title, loop[i]) ? static_cast<int>(i) : -1;
+            if (matcher.firstMatch(title) != expected || matcher.matches(title) != (expected >= 0)) {
+                std::fprintf(stderr, "rules \"%s\" disagree on \"%s\"\n", rules.c_str(), title.c_str());
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void benchRuleMatching() {
+        const auto titles = makeTitles(4096);
+
+        for (const auto& set : RULE_SETS) {
+            CRuleMatcher matcher;
+            matcher.compile(set.rules);
+
+            if (auto* r = measure(std::string("rules/match/") + set.name, titles.size(), [&] {
+                    size_t hits = 0;
+                    for (const auto& title : titles)
+                        hits += matcher.matches(title);
+                    doNotOptimize(hits);
+                }))
+                r->counters.emplace_back("rules", matcher.ruleCount());
+
+            measure(std::string("rules/compile/") + set.name, 1, [&] {
+                CRuleMatcher m;
+                m.compile(set.rules);
+                doNotOptimize(m);
+            });
+        }
+
+        // The pre-CRuleMatcher approach, one std::regex per rule, as a baseline
+        std::vector<std::regex> legacy;
+        for (const char* rule : {"kitty", "foot", "^htop", "Steam$", "term.*al", "fire(fox|dragon)", "[0-9]+ unread", ".*\\.rs$"})
+            legacy.emplace_back(rule, std::regex::ECMAScript | std::regex::icase);
+
+        // The compiled matcher has to agree with trying the rules one by one,
+        // in order. Besides the benchmark sets, rules whose classes hold
+        // brackets or bars, alternations around a literal, escapes that
+        // spell a character with the text after them, and stacked quantifiers.
+        std::vector<std::string> checkTitles = titles;
+        for (const char* title : {"bar", "foo", ")x", "(", "[x]", "a|b", "kitty", "xfooy", "ab", "cd", "abb", "kk", "cbb", "App", "a\nb", "", "A-", "aab"})
+            checkTitles.emplace_back(title);
+
+        for (const char* rules : {RULE_SETS[4].rules, RULE_SETS[3].rules, "[(]foo|bar", "[)]x|kitty", "[|]|zzz", "[\\]]x|foo", "ab(c|d)?|cd", "^(foo|b)ar$;[a-c]b",
+                                  "(x);(a)(b)\\2", "(k)\\1|zz;(c|a)(b)\\2", "\\x41pp;\\u0041pp", "a\\cJb;zz", "(a*)\\1", "c+*;A{2}+", "c+??;x", "a+?b"})
+            check(agreesWithRegexLoop(rules, checkTitles), rules);
+
+        measure("rules/match/mixed_legacy", titles.size(), [&] {
+            size_t hits = 0;
+            for (const auto& title : titles) {
+                for (const auto& re : legacy) {
+                    if (std::regex_search(title, re)) {
+                        hits++;
+                        break;
+                    }
+                }
+            }
+            doNotOptimize(hits);
+        });
+    }
+
+    // Compiles `rules` with every other key at its default
+    std::unique_ptr<const NConfig::SSnapshot> compileRules(const char* rules, std::vector<std::string>& errors) {
+        const std::map<std::string, std::string> config = {
+            {"plugin:glasswindow:rules", rules},
+            {"plugin:glasswindow:strength", "0.7"},
+            {"plugin:glasswindow:blur_step", "0.01"},
+            {"plugin:glasswindow:chromatic_aberration", "0.0"},
+            {"plugin:glasswindow:opacity", "0.9"},
+            {"plugin:glasswindow:distortion_seed", "0"},
+            {"plugin:glasswindow:batch", "0"},
+            {"plugin:glasswindow:stats", "0"},
+            {"plugin:glasswindow:governor", "1"},
+            {"plugin:glasswindow:governor_degrade_at", "0.25"},
+            {"plugin:glasswindow:governor_restore_at", "0.1"},
+            {"plugin:glasswindow:governor_degrade_frames", "3"},
+            {"plugin:glasswindow:governor_restore_frames", "60"},
+            {"plugin:glasswindow:governor_tiny_area", "40000"},
+        };
+
+        return NConfig::compile([&](const std::string& key) { return config.at(key); }, 1, errors);
+    }
+
+    // The profile index each title ends up with, -1 for no glass
+    bool profilesAre(const char* rules, std::initializer_list<std::pair<const char*, int>> expected) {
+        std::vector<std::string> errors;
+        const auto               snapshot = compileRules(rules, errors);
+        if (!snapshot || !errors.empty())
+            return false;
+
+        for (const auto& [title, profile] : expected) {
+            if (snapshot->profileFor(title) != profile) {
+                std::fprintf(stderr, "rules \"%s\" give \"%s\" profile %d\n", rules, title, snapshot->profileFor(title));
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void checkRuleProfiles() {
+        // The example from the README
+        check(profilesAre("kitty => strength=0.4, alpha=0.95; ^Mozilla Firefox$ => chromatic=0; .*",
+                          {{"kitty", 1}, {"Mozilla Firefox", 2}, {"ExampleWindowTitle", 0}, {"htop", 0}}),
+              "README rules example");
+        check(profilesAre("kitty; foot", {{"kitty", 0}, {"foot", 0}, {"htop", -1}}), "blanks around rules are ignored");
+
+        // Per-rule keys take the global keys' 0-1 ranges, out of range drops the rule
+        for (const char* rules : {"kitty => chromatic=1.5; .*", "kitty => blur_step=2; .*", "kitty => strength=-0.1; .*"}) {
+            std::vector<std::string> errors;
+            const auto               snapshot = compileRules(rules, errors);
+            check(snapshot && errors.size() == 1 && snapshot->profileFor("kitty") == 0, rules);
+        }
+    }
+
+    void benchPlugin() {
+        NMockHyprland::reset();
+        PLUGIN_INIT(reinterpret_cast<HANDLE>(0x1));
+
+        for (const auto& set : RULE_SETS) {
+            NMockHyprland::setConfigValue("plugin:glasswindow:rules", set.rules);
+            measure(std::string("plugin/reloadConfig/") + set.name, 1, [] { NMockHyprland::emit("configReload"); });
+        }
+
+        NMockHyprland::setConfigValue("plugin:glasswindow:rules",
+                                      "kitty => strength=0.4, alpha=0.95;foot => blur_step=0.02;fire(fox|dragon) => chromatic=0.004;term.*al => strength=0.2, chromatic=0, alpha=1;.*");
+        measure("plugin/reloadConfig/profiles", 1, [] { NMockHyprland::emit("configReload"); });
+
+        // A value that doesn't parse is reported and the running config stays
+        {
+            const size_t notifications = NMockHyprland::notificationCount();
+            const long   generation    = jsonNumber(NMockHyprland::hyprctl("glasswindow", "stats"), "config_generation");
+
+            NMockHyprland::setConfigValue("plugin:glasswindow:strength", "strong");
+            NMockHyprland::emit("configReload");
+            check(NMockHyprland::notificationCount() == notifications + 1, "invalid value is reported");
+            check(jsonNumber(NMockHyprland::hyprctl("glasswindow", "stats"), "config_generation") == generation, "invalid value keeps the snapshot");
+
+            NMockHyprland::setConfigValue("plugin:glasswindow:strength", "0.7");
+            NMockHyprland::setConfigValue("plugin:glasswindow:governor_restore_at", "0.25");
+            NMockHyprland::emit("configReload");
+            check(NMockHyprland::notificationCount() == notifications + 2, "governor thresholds without a gap are reported");
+            check(jsonNumber(NMockHyprland::hyprctl("glasswindow", "stats"), "config_generation") == generation, "governor thresholds without a gap keep the snapshot");
+
+            NMockHyprland::setConfigValue("plugin:glasswindow:governor_restore_at", "0.1");
+            NMockHyprland::setConfigValue("plugin:glasswindow:rules", "kitty => sharpness=2;.*");
+            NMockHyprland::emit("configReload");
+            check(NMockHyprland::notificationCount() == notifications + 3, "invalid profile is reported");
+            check(jsonNumber(NMockHyprland::hyprctl("glasswindow", "stats"), "config_generation") == generation + 1, "invalid profile only drops its rule");
+        }
+        NMockHyprland::setConfigValue("plugin:glasswindow:rules", ".*");
+
+        // Steady state: every window's rule decision is already cached. One
+        // preRender per batch of windows, as if they were all on one monitor.
+        constexpr size_t    WINDOWS     = 64;
+        constexpr uintptr_t MONITOR     = 0x1000; // Hyprland never passes a null monitor
+        const auto          renderFrame = [] {
+            for (size_t i = 1; i <= WINDOWS; ++i)
+                NMockHyprland::emit("renderWindow", reinterpret_cast<void*>(i));
+            NMockHyprland::emit("preRender", reinterpret_cast<void*>(MONITOR));
+        };
+
+        // The steady state render path must not touch the heap
+        const auto measureFrames = [&](const std::string& name) {
+            if (auto* r = measure(name, WINDOWS, renderFrame)) {
+                const double allocs = allocationsPerCall(renderFrame) / WINDOWS;
+                r->counters.emplace_back("allocs_per_op", allocs);
+                check(allocs == 0.0, "render path does not allocate");
+            }
+        };
+
+        // Untimed path: stats and governor off
+        NMockHyprland::setConfigValue("plugin:glasswindow:governor", "0");
+        NMockHyprland::emit("configReload");
+        measureFrames("plugin/renderWindow/cached");
+
+        NMockHyprland::setConfigValue("plugin:glasswindow:batch", "1");
+        NMockHyprland::emit("configReload");
+        measureFrames("plugin/renderWindow/batched");
+
+        // Windows that stay put fall back to their own blur only in the first
+        // frame after a reload, from then on the shared blur covers them
+        NMockHyprland::emit("configReload");
+        NMockHyprland::hyprctl("glasswindow", "reset");
+        for (int i = 0; i < 8; ++i)
+            renderFrame();
+        {
+            const auto stats = NMockHyprland::hyprctl("glasswindow", "stats");
+            check(jsonNumber(stats, "fallbacks") == static_cast<long>(WINDOWS), "shared blur covers windows that stay put");
+            check(jsonNumber(stats, "shared_blurs") == 1, "shared blur is redone only on damage");
+        }
+
+        // A window left out for a frame falls back with the same box. Its own
+        // backdrop missed the damage while it was covered, reusing it is wrong.
+        NMockHyprland::hyprctl("glasswindow", "reset");
+        for (size_t i = 1; i < WINDOWS; ++i)
+            NMockHyprland::emit("renderWindow", reinterpret_cast<void*>(i));
+        NMockHyprland::emit("preRender", reinterpret_cast<void*>(MONITOR));
+        renderFrame();
+        check(jsonNumber(NMockHyprland::hyprctl("glasswindow", "stats"), "misses") == 1, "covered window's own backdrop is dropped");
+        NMockHyprland::setConfigValue("plugin:glasswindow:batch", "0");
+
+        NMockHyprland::setConfigValue("plugin:glasswindow:governor", "1");
+        NMockHyprland::emit("configReload");
+        measureFrames("plugin/renderWindow/governor");
+
+        // The mock's timer queries report 0 ns, as a real driver does while the
+        // draws are placeholders. The plugin's CPU time has to reach the
+        // governor anyway: with a tiny budget share it has to degrade.
+        NMockHyprland::setConfigValue("plugin:glasswindow:governor_degrade_at", "0.0001");
+        NMockHyprland::setConfigValue("plugin:glasswindow:governor_restore_at", "0.00001");
+        NMockHyprland::emit("configReload");
+        for (int i = 0; i < 16; ++i)
+            renderFrame();
+        {
+            const auto stats = NMockHyprland::hyprctl("glasswindow", "stats");
+            check(stats.find(R"("governor_clock": "cpu+gpu")") != std::string::npos, "governor reads GPU time when timer queries exist");
+            check(jsonNumber(stats, "quality_level") > 0, "governor sees CPU time next to GPU time");
+        }
+        NMockHyprland::setConfigValue("plugin:glasswindow:governor_degrade_at", "0.25");
+        NMockHyprland::setConfigValue("plugin:glasswindow:governor_restore_at", "0.1");
+        NMockHyprland::emit("configReload");
+
+        NMockHyprland::setConfigValue("plugin:glasswindow:stats", "1");
+        NMockHyprland::emit("configReload");
+        measureFrames("plugin/renderWindow/instrumented");
+
+        measure("plugin/hyprctl/stats", 1, [] { doNotOptimize(NMockHyprland::hyprctl("glasswindow", "stats")); });
+
+        // The frame count is the one inside "frames", the outer key holds the object
+        const auto recordedFrames = [] {
+            const auto stats = NMockHyprland::hyprctl("glasswindow", "stats");
+            return jsonNumber(stats.substr(stats.find(R"("enabled")")), "frames");
+        };
+        for (int i = 0; i < 4; ++i)
+            renderFrame();
+        check(recordedFrames() > 0, "stats record frames");
+        check(NMockHyprland::hyprctl("glasswindow", "reset") == "ok" && recordedFrames() == 0, "reset clears the frame stats");
+        {
+            const auto stats = NMockHyprland::hyprctl("glasswindow", "stats");
+            check(jsonNumber(stats, "hits") == 0 && jsonNumber(stats, "partials") == 0 && jsonNumber(stats, "misses") == 0, "reset clears the backdrop cache stats");
+        }
+        check(NMockHyprland::hyprctl("glasswindow", "") == NMockHyprland::hyprctl("glasswindow", "stats"), "no argument prints the stats");
+        check(NMockHyprland::hyprctl("glasswindow", "rest").starts_with("error:"), "unknown hyprctl argument is an error");
+
+        PLUGIN_EXIT();
+        NMockHyprland::reset();
+    }
+
+    // Pulls "key": <number> out of the summary of `counter`
+    long summaryNumber(const std::string& json, const std::string& counter, const std::string& key) {
+        const size_t at = json.find("\"" + counter + "\": ");
+        return at == std::string::npos ? -1 : jsonNumber(json.substr(at), key);
+    }
+
+    void checkFrameStats() {
+        CFrameStats stats;
+        stats.setEnabled(true);
+
+        // 1..100 us in shuffled order, with an idle frame after each
+        std::vector<uint64_t> costs(100);
+        for (size_t i = 0; i < costs.size(); ++i)
+            costs[i] = (i + 1) * 1000;
+        std::shuffle(costs.begin(), costs.end(), std::mt19937(3));
+
+        for (uint64_t cost : costs) {
+            stats.current().callbackNs = cost;
+            stats.current().windows    = 1;
+            stats.endFrame();
+            stats.endFrame();
+        }
+
+        const auto json = stats.json();
+        check(jsonNumber(json, "frames") == 100, "frame stats skip frames without windows");
+        check(summaryNumber(json, "callback_ns", "p50") == 50000, "frame stats p50");
+        check(summaryNumber(json, "callback_ns", "p99") == 99000, "frame stats p99");
+        check(summaryNumber(json, "callback_ns", "max") == 100000, "frame stats max");
+
+        // Only the last CAPACITY frames are kept
+        for (size_t i = 0; i < CFrameStats::CAPACITY; ++i) {
+            stats.current().callbackNs = 7;
+            stats.current().windows    = 1;
+            stats.endFrame();
+        }
+        check(jsonNumber(stats.json(), "frames") == static_cast<long>(CFrameStats::CAPACITY) && summaryNumber(stats.json(), "callback_ns", "max") == 7,
+              "frame stats keep the last CAPACITY frames");
+
+        stats.reset();
+        check(jsonNumber(stats.json(), "frames") == 0 && summaryNumber(stats.json(), "callback_ns", "max") == 0, "frame stats reset");
+    }
+
+    // Closed loop run of the governor: the cost of a frame depends on the
+    // level it picked. Calm, a heavy stretch, calm again, with noise. Under
+    // load it has to stop at the first level that fits the budget, not go
+    // past it, and come back to full quality once the load is gone.
+    struct SGovernorRun {
+        size_t changes    = 0;
+        size_t fullFrames = 0; // frames run at QUALITY_FULL
+        int    worst      = 0;
+        int    afterHeavy = 0; // level at the end of the heavy stretch
+        int    final      = 0;
+    };
+
+    SGovernorRun runGovernor(CQualityGovernor& governor, const float (&calm)[CQualityGovernor::QUALITY_LEVELS],
+                             const float (&heavy)[CQualityGovernor::QUALITY_LEVELS], uint64_t budget, size_t frames) {
+        std::mt19937 rng(7);
+        SGovernorRun run;
+
+        governor.reset();
+        for (size_t i = 0; i < frames; ++i) {
+            const bool  loaded = i >= frames / 3 && i < 2 * frames / 3;
+            const float noise  = (rng() % 1000) / 1000.f * 0.06f - 0.03f;
+            const float share  = (loaded ? heavy : calm)[governor.level()] + noise;
+
+            run.changes += governor.onFrame(static_cast<uint64_t>(std::max(share, 0.f) * budget), budget);
+            run.worst = std::max<int>(run.worst, governor.level());
+            run.fullFrames += governor.level() == CQualityGovernor::QUALITY_FULL;
+            if (i + 1 == 2 * frames / 3)
+                run.afterHeavy = governor.level();
+        }
+        run.final = governor.level();
+        return run;
+    }
+
+    void benchGovernor() {
+        constexpr uint64_t BUDGET = 1'000'000'000 / 144;
+        constexpr size_t   FRAMES = 3000;
+
+        // Default thresholds: degrade above 0.25, restore below 0.10.
+        // Under load level 1 is the first that fits; level 2 would sit
+        // between the thresholds and never come back up.
+        const float calm[]  = {0.05f, 0.04f, 0.03f, 0.02f, 0.01f};
+        const float heavy[] = {0.40f, 0.20f, 0.15f, 0.08f, 0.03f};
+
+        CQualityGovernor governor;
+        SGovernorRun     run;
+
+        auto*            r = measure("governor/trace", FRAMES, [&] { run = runGovernor(governor, calm, heavy, BUDGET, FRAMES); });
+
+        if (r) {
+            r->counters.emplace_back("level_changes", run.changes);
+            r->counters.emplace_back("worst_level", run.worst);
+            r->counters.emplace_back("level_after_heavy", run.afterHeavy);
+            r->counters.emplace_back("final_level", run.final);
+
+            check(run.worst == CQualityGovernor::QUALITY_CHEAP_TAPS && run.afterHeavy == CQualityGovernor::QUALITY_CHEAP_TAPS,
+                  "governor settles at the lowest sufficient level");
+            check(run.final == CQualityGovernor::QUALITY_FULL, "governor returns to FULL");
+            check(run.changes == 2, "governor steps once down and once up");
+        }
+
+        // Full quality is over degradeAt and the next level under restoreAt,
+        // so every restore fails. 10 s at 144 Hz: without backoff that is a
+        // flip every half second, with it the probes get rarer and full
+        // quality shows up for a few frames at a time.
+        constexpr size_t STRADDLE_FRAMES = 1440;
+        const float      straddle[]      = {0.40f, 0.05f, 0.04f, 0.03f, 0.02f};
+
+        if (auto* r = measure("governor/straddle", STRADDLE_FRAMES, [&] { run = runGovernor(governor, straddle, straddle, BUDGET, STRADDLE_FRAMES); })) {
+            r->counters.emplace_back("level_changes", run.changes);
+            r->counters.emplace_back("full_frames", run.fullFrames);
+
+            check(run.changes <= 10, "governor backs off restores that fail");
+            check(run.fullFrames < STRADDLE_FRAMES / 20, "governor stays below a level that doesn't fit");
+        }
+    }
+
+    void checkBackdropCache() {
+        constexpr int      RADIUS = 16;
+        const SRect        box{100, 100, 400, 300};
+        void* const        window = reinterpret_cast<void*>(static_cast<uintptr_t>(1));
+        CBackdropCache     cache;
+        std::vector<SRect> redo;
+
+        const auto         update = [&](const SRect& at, std::initializer_list<SRect> damage) {
+            const std::vector<SRect> rects(damage);
+            return cache.update(window, at, rects, RADIUS, redo);
+        };
+
+        check(update(box, {}) == CBackdropCache::CACHE_MISS && redo == std::vector<SRect>{box}, "backdrop cache: first frame is a miss");
+        check(update(box, {}) == CBackdropCache::CACHE_HIT && redo.empty(), "backdrop cache: undamaged box is a hit");
+
+        // Ends RADIUS + 4 px left of the box, the footprint doesn't reach it
+        check(update(box, {{60, 200, 20, 20}}) == CBackdropCache::CACHE_HIT && redo.empty(), "backdrop cache: damage outside the footprint is a hit");
+
+        // Grown by RADIUS it sticks out of the box on the left, the redo rect must not
+        check(update(box, {{90, 150, 20, 20}}) == CBackdropCache::CACHE_PARTIAL && redo == std::vector<SRect>{{100, 134, 26, 52}},
+              "backdrop cache: damage inside the footprint is a partial clipped to the box");
+
+        // Smaller than the box, but its footprint covers all of it
+        check(update(box, {{110, 110, 380, 280}}) == CBackdropCache::CACHE_MISS && redo == std::vector<SRect>{box},
+              "backdrop cache: damage covering the box is a miss");
+
+        const SRect moved{110, 100, 400, 300};
+        check(update(moved, {}) == CBackdropCache::CACHE_MISS && redo == std::vector<SRect>{moved}, "backdrop cache: changed box is a miss");
+
+        const auto& stats = cache.stats();
+        check(stats.hits == 2 && stats.partials == 1 && stats.misses == 3, "backdrop cache: stats count every result");
+    }
+
+    // Shared backdrop region of a cascade of overlapping windows on a 1080p
+    // monitor. blurred_area / window_area is what batching saves in blur
+    // fill over blurring every window on its own.
+    void benchBatch() {
+        const SRect bounds{0, 0, 1920, 1080};
+
+        for (int windows : {4, 16, 64}) {
+            CBackdropBatch batch;
+            for (int i = 0; i < windows; ++i)
+                batch.addWindow(reinterpret_cast<void*>(static_cast<uintptr_t>(i + 1)), {100 + (i % 16) * 40, 80 + (i % 16) * 30, 900, 600});
+
+            long   covered = 0;
+            auto*  r       = measure("batch/region/" + std::to_string(windows), 1, [&] {
+                const auto& region = batch.region(48, bounds);
+                covered            = CBackdropBatch::area(region);
+                doNotOptimize(covered);
+            });
+
+            if (r) {
+                // Each window blurred alone reads its box grown by the same footprint
+                long separate = 0;
+                for (int i = 0; i < windows; ++i)
+                    separate += SRect{100 + (i % 16) * 40, 80 + (i % 16) * 30, 900, 600}.expanded(48).intersection(bounds).area();
+
+                r->counters.emplace_back("rects", batch.region(48, bounds).size());
+                r->counters.emplace_back("blurred_area", covered);
+                r->counters.emplace_back("window_area", separate);
+            }
+        }
+    }
+
+    // FNV-1a of the texels, pins the generator's output bit for bit
+    uint64_t fingerprint(const NDistortion::SField& field) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (uint8_t texel : field.texels) {
+            hash ^= texel;
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Largest step between neighbouring texels, inside the field and across
+    // its edges. With GL_REPEAT the edge step is just another step, so a
+    // seam shows up as one bigger than any inside.
+    bool wrapsSeamlessly(const NDistortion::SField& field) {
+        constexpr int SIZE = NDistortion::SIZE;
+        const auto    at   = [&](int x, int y, int c) { return static_cast<int>(field.texels[(static_cast<size_t>(y) * SIZE + x) * 2 + c]); };
+
+        int inner = 0, edge = 0;
+        for (int c = 0; c < 2; ++c) {
+            for (int a = 0; a < SIZE; ++a) {
+                for (int b = 0; b + 1 < SIZE; ++b)
+                    inner = std::max({inner, std::abs(at(b + 1, a, c) - at(b, a, c)), std::abs(at(a, b + 1, c) - at(a, b, c))});
+                edge = std::max({edge, std::abs(at(0, a, c) - at(SIZE - 1, a, c)), std::abs(at(a, 0, c) - at(a, SIZE - 1, c))});
+            }
+        }
+
+        return edge <= inner;
+    }
+
+    void benchDistortion() {
+        measure("distortion/generate", 1, [] { doNotOptimize(NDistortion::generate(0)); });
+
+        // Integer-only generation, so these hold on every machine and compiler
+        const auto field = NDistortion::generate(0);
+        check(field.texels.size() == static_cast<size_t>(NDistortion::SIZE) * NDistortion::SIZE * 2, "distortion field size");
+        check(fingerprint(field) == 0x891c9836e4b016f6ULL, "distortion field for seed 0");
+        check(fingerprint(NDistortion::generate(0xdeadbeef)) == 0x4a0db468416d07c7ULL, "distortion field for seed 0xdeadbeef");
+        check(NDistortion::generate(1).texels != field.texels, "seeds give different distortion fields");
+
+        for (uint32_t seed : {0u, 1u, 0xdeadbeefu})
+            check(wrapsSeamlessly(NDistortion::generate(seed)), "distortion field wraps seamlessly");
+    }
+
+    NBlur::SImage makeFrame(int width, int height) {
+        NBlur::SImage frame(width, height);
+        std::mt19937  rng(42);
+
+        // Checkerboard plus noise: a blur that does nothing would show up
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const float checker = ((x / 32 + y / 32) % 2) ? 0.8f : 0.2f;
+                const float n       = (rng() % 256) / 2550.f;
+                frame.at(x, y)      = {checker + n, checker, 1.f - checker, 1.f};
+            }
+        }
+
+        return frame;
+    }
+
+    // Fetches per output pixel blur.hpp promises: 10 in glass.frag with 8
+    // upsample taps and distortion, under 5/3 + 8/3 for the chain, 2 for chromatic
+    double maxFetchesPerPixel(const NBlur::SGlassParams& params) {
+        return 1.0 + params.up_taps + (params.distortion ? 1 : 0) + (params.chromatic ? 2 : 0) + NBlur::DOWN_TAPS / 3.0 + params.up_taps / 3.0;
+    }
+
+    // The CPU reference against what blur.hpp says about it: a flat frame
+    // stays flat, 2 * passes GPU passes, every pass fetches what its shader
+    // does, and a larger radius adds passes but no fetches per pixel
+    void checkPipeline() {
+        constexpr int       WIDTH = 256, HEIGHT = 192;
+        const NBlur::SPixel COLOR = {0.25f, 0.5f, 0.75f, 1.f};
+
+        struct SRadius {
+            float blurStep, strength;
+        };
+
+        // Growing radius, from one pass up to what this size allows
+        constexpr SRadius RADII[] = {{0.01f, 0.5f}, {0.05f, 0.5f}, {0.1f, 0.5f}, {0.1f, 1.f}, {0.5f, 1.f}};
+
+        NBlur::SImage     flat(WIDTH, HEIGHT);
+        std::fill(flat.pixels.begin(), flat.pixels.end(), COLOR);
+
+        for (int upTaps : {NBlur::UP_TAPS, NBlur::UP_TAPS_CHEAP}) {
+            NBlur::SGlassParams params;
+            params.chromatic = true;
+            params.up_taps   = upTaps;
+
+            int lastPasses = 0;
+            for (const auto& radius : RADII) {
+                params.blur_step = radius.blurStep;
+                params.strength  = radius.strength;
+
+                std::vector<NBlur::SPassCost> costs;
+                const auto                    out  = NBlur::run(flat, params, &costs);
+                const auto                    plan = NBlur::planBlur(params, WIDTH, HEIGHT);
+
+                const bool                    unchanged = std::all_of(out.pixels.begin(), out.pixels.end(), [&](const NBlur::SPixel& p) {
+                    return std::abs(p.r - COLOR.r) < 1e-5f && std::abs(p.g - COLOR.g) < 1e-5f && std::abs(p.b - COLOR.b) < 1e-5f && std::abs(p.a - COLOR.a) < 1e-5f;
+                });
+                check(unchanged, "blur leaves a flat frame unchanged");
+                check(plan.passes > lastPasses, "larger blur radius runs more passes");
+                check(costs.size() == 2 * static_cast<size_t>(plan.passes), "blur runs 2 * passes GPU passes");
+                lastPasses = plan.passes;
+
+                uint64_t fetches = 0;
+                for (size_t i = 0; i < costs.size(); ++i) {
+                    const auto&    cost   = costs[i];
+                    const uint64_t pixels = static_cast<uint64_t>(cost.width) * cost.height;
+                    fetches += cost.fetches;
+
+                    if (i < static_cast<size_t>(plan.passes))
+                        check(!std::strcmp(cost.name, "down") && cost.fetches == pixels * NBlur::DOWN_TAPS, "downsample fetches DOWN_TAPS per pixel");
+                    else if (i + 1 < costs.size())
+                        check(!std::strcmp(cost.name, "up") && cost.fetches == pixels * upTaps, "upsample fetches up_taps per pixel");
+                    else
+                        check(!std::strcmp(cost.name, "composite") && cost.width == WIDTH && cost.height == HEIGHT && cost.fetches == pixels * (1 + upTaps + 1 + 2),
+                              "composite fetches original, upsample taps, distortion and chromatic");
+                }
+
+                check(static_cast<double>(fetches) / (WIDTH * HEIGHT) < maxFetchesPerPixel(params), "blur stays within its fetch budget");
+            }
+        }
+    }
+
+    void benchPipeline() {
+        checkPipeline();
+
+        struct SResolution {
+            const char* name;
+            int         width, height;
+        };
+
+        for (const auto& res : {SResolution{"1080p", 1920, 1080}, SResolution{"4k", 3840, 2160}}) {
+            const std::string name = std::string("pipeline/cpu/") + res.name;
+            if (!selected(name))
+                continue;
+
+            const auto          frame = makeFrame(res.width, res.height);
+            NBlur::SGlassParams params;
+            params.chromatic = true;
+
+            std::vector<NBlur::SPassCost> costs;
+            auto* r = measure(name, 1, [&] {
+                costs.clear();
+                doNotOptimize(NBlur::run(frame, params, &costs));
+            });
+
+            uint64_t fetches = 0;
+            for (const auto& cost : costs)
+                fetches += cost.fetches;
+
+            const auto plan = NBlur::planBlur(params, res.width, res.height);
+            r->counters.emplace_back("passes", plan.passes);
+            r->counters.emplace_back("gpu_passes", costs.size());
+            r->counters.emplace_back("fetches_per_pixel", static_cast<double>(fetches) / (static_cast<double>(res.width) * res.height));
+            r->counters.emplace_back("max_fetches_per_pixel", maxFetchesPerPixel(params));
+        }
+    }
+
+    void writeJson() {
+        char         date[32];
+        const time_t now = std::time(nullptr);
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+        std::printf("{\n  \"context\": {\"date\": \"%s\", \"min_time\": %g},\n  \"benchmarks\": [", date, g_options.minTime);
+
+        for (size_t i = 0; i < g_results.size(); ++i) {
+            const auto& r = g_results[i];
+            std::printf("%s\n    {\"name\": \"%s\", \"iterations\": %llu, \"ns_per_op\": %.3f, \"ops_per_sec\": %.1f", i ? "," : "", r.name.c_str(),
+                        static_cast<unsigned long long>(r.iterations), r.nsPerOp, 1e9 / r.nsPerOp);
+            for (const auto& [key, value] : r.counters)
+                std::printf(", \"%s\": %g", key.c_str(), value);
+            std::printf("}");
+        }
+
+        std::printf("\n  ]\n}\n");
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+            g_options.filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--min-time") && i + 1 < argc)
+            g_options.minTime = std::stod(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: %s [--filter <substring>] [--min-time <seconds>]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    benchRuleMatching();
+    checkRuleProfiles();
+    checkFrameStats();
+    benchPlugin();
+    benchGovernor();
+    checkBackdropCache();
+    benchBatch();
+    benchDistortion();
+    benchPipeline();
+
+    writeJson();
+    return g_failedChecks ? 1 : 0;
+}
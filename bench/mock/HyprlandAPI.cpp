@@ -0,0 +1,75 @@
+#include <HyprlandAPI.hpp>
+
+#include <unordered_map>
+
+namespace {
+
+    struct SMockState {
+        std::unordered_map<std::string, std::string>                m_config;
+        std::unordered_map<std::string, std::function<void(void*)>> m_callbacks;
+        std::unordered_map<std::string, std::function<std::string(const std::string&)>> m_hyprctl;
+        size_t                                                      m_notifications = 0;
+    };
+
+    SMockState& state() {
+        static SMockState s;
+        return s;
+    }
+
+} // namespace
+
+void HyprlandAPI::addConfigValue(HANDLE handle, const std::string& name, const std::string& value) {
+    // Like Hyprland, registering a key doesn't override what the user set
+    state().m_config.try_emplace(name, value);
+}
+
+std::string HyprlandAPI::getConfigValue(HANDLE handle, const std::string& name) {
+    auto it = state().m_config.find(name);
+    return it == state().m_config.end() ? std::string{} : it->second;
+}
+
+void HyprlandAPI::registerCallback(HANDLE handle, const std::string& event, std::function<void(void*)> fn) {
+    state().m_callbacks[event] = std::move(fn);
+}
+
+void HyprlandAPI::unregisterCallback(HANDLE handle, const std::string& event) {
+    state().m_callbacks.erase(event);
+}
+
+void HyprlandAPI::addNotification(HANDLE handle, const std::string& title, const std::string& text, const std::string& type, int timeoutMs) {
+    state().m_notifications++;
+}
+
+void HyprlandAPI::registerHyprCtlCommand(HANDLE handle, const std::string& name, std::function<std::string(const std::string&)> fn) {
+    state().m_hyprctl[name] = std::move(fn);
+}
+
+void HyprlandAPI::unregisterHyprCtlCommand(HANDLE handle, const std::string& name) {
+    state().m_hyprctl.erase(name);
+}
+
+void NMockHyprland::setConfigValue(const std::string& name, const std::string& value) {
+    state().m_config[name] = value;
+}
+
+bool NMockHyprland::emit(const std::string& event, void* data) {
+    auto it = state().m_callbacks.find(event);
+    if (it == state().m_callbacks.end())
+        return false;
+
+    it->second(data);
+    return true;
+}
+
+std::string NMockHyprland::hyprctl(const std::string& name, const std::string& args) {
+    auto it = state().m_hyprctl.find(name);
+    return it == state().m_hyprctl.end() ? std::string{} : it->second(args);
+}
+
+size_t NMockHyprland::notificationCount() {
+    return state().m_notifications;
+}
+
+void NMockHyprland::reset() {
+    state() = {};
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+// Stand-in for the slice of the Hyprland plugin API that glasswindow uses, so
+// the plugin logic can be built and measured without a running compositor.
+
+#include <functional>
+#include <string>
+
+using HANDLE = void*;
+
+namespace HyprlandAPI {
+    void        addConfigValue(HANDLE handle, const std::string& name, const std::string& value);
+    std::string getConfigValue(HANDLE handle, const std::string& name);
+    void        registerCallback(HANDLE handle, const std::string& event, std::function<void(void*)> fn);
+    void        unregisterCallback(HANDLE handle, const std::string& event);
+    void        addNotification(HANDLE handle, const std::string& title, const std::string& text, const std::string& type, int timeoutMs);
+    void        registerHyprCtlCommand(HANDLE handle, const std::string& name, std::function<std::string(const std::string&)> fn);
+    void        unregisterHyprCtlCommand(HANDLE handle, const std::string& name);
+}
+
+// Test-side controls for the mock
+namespace NMockHyprland {
+    // Overrides a config value, as if the user edited hyprland.conf
+    void        setConfigValue(const std::string& name, const std::string& value);
+
+    // Fires every callback registered for `event`. Returns false if none is registered.
+    bool        emit(const std::string& event, void* data = nullptr);
+
+    // Runs `hyprctl <name> <args>`, returns an empty string for unknown commands
+    std::string hyprctl(const std::string& name, const std::string& args = "");
+
+    size_t      notificationCount();
+    void        reset();
+}
@@ -0,0 +1,104 @@
+// No-op GLES entry points for the headless bench. Every shader compiles and
+// links, every object gets a fresh id, nothing is drawn. Timer queries are
+// supported and finish instantly, taking 0 ns.
+
+#include <EGL/egl.h>
+#include <GLES3/gl32.h>
+#include <GLES2/gl2ext.h>
+
+#include <cstring>
+
+namespace {
+    GLuint g_nextId = 1;
+
+    void genQueries(GLsizei n, GLuint* ids) {
+        for (GLsizei i = 0; i < n; ++i)
+            ids[i] = g_nextId++;
+    }
+    void deleteQueries(GLsizei, const GLuint*) {}
+    void beginQuery(GLenum, GLuint) {}
+    void endQuery(GLenum) {}
+    void getQueryObjectuiv(GLuint, GLenum pname, GLuint* params) {
+        *params = pname == GL_QUERY_RESULT_AVAILABLE_EXT ? GL_TRUE : 0;
+    }
+    void getQueryObjectui64v(GLuint, GLenum, GLuint64* params) {
+        *params = 0;
+    }
+}
+
+extern "C" {
+
+GLuint glCreateShader(GLenum) {
+    return g_nextId++;
+}
+void glShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+void glCompileShader(GLuint) {}
+void glDeleteShader(GLuint) {}
+
+GLuint glCreateProgram() {
+    return g_nextId++;
+}
+void glAttachShader(GLuint, GLuint) {}
+void glDetachShader(GLuint, GLuint) {}
+void glLinkProgram(GLuint) {}
+void glDeleteProgram(GLuint) {}
+
+void glGetShaderiv(GLuint, GLenum, GLint* params) {
+    *params = GL_TRUE;
+}
+void glGetProgramiv(GLuint, GLenum, GLint* params) {
+    *params = GL_TRUE;
+}
+void glGetShaderInfoLog(GLuint, GLsizei, GLsizei* length, GLchar*) {
+    if (length)
+        *length = 0;
+}
+void glGetProgramInfoLog(GLuint, GLsizei, GLsizei* length, GLchar*) {
+    if (length)
+        *length = 0;
+}
+
+GLint glGetUniformLocation(GLuint, const GLchar*) {
+    return -1;
+}
+GLint glGetAttribLocation(GLuint, const GLchar*) {
+    return -1;
+}
+
+void glGenTextures(GLsizei n, GLuint* textures) {
+    for (GLsizei i = 0; i < n; ++i)
+        textures[i] = g_nextId++;
+}
+void glDeleteTextures(GLsizei, const GLuint*) {}
+void glBindTexture(GLenum, GLuint) {}
+void glTexParameteri(GLenum, GLenum, GLint) {}
+void glPixelStorei(GLenum, GLint) {}
+void glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) {}
+
+const GLubyte* glGetString(GLenum name) {
+    return reinterpret_cast<const GLubyte*>(name == GL_EXTENSIONS ? "GL_EXT_disjoint_timer_query" : "");
+}
+void glGetIntegerv(GLenum, GLint* data) {
+    *data = 0;
+}
+
+__eglMustCastToProperFunctionPointerType eglGetProcAddress(const char* name) {
+    static const struct {
+        const char*                              name;
+        __eglMustCastToProperFunctionPointerType fn;
+    } FUNCTIONS[] = {
+        {"glGenQueriesEXT", reinterpret_cast<__eglMustCastToProperFunctionPointerType>(genQueries)},
+        {"glDeleteQueriesEXT", reinterpret_cast<__eglMustCastToProperFunctionPointerType>(deleteQueries)},
+        {"glBeginQueryEXT", reinterpret_cast<__eglMustCastToProperFunctionPointerType>(beginQuery)},
+        {"glEndQueryEXT", reinterpret_cast<__eglMustCastToProperFunctionPointerType>(endQuery)},
+        {"glGetQueryObjectuivEXT", reinterpret_cast<__eglMustCastToProperFunctionPointerType>(getQueryObjectuiv)},
+        {"glGetQueryObjectui64vEXT", reinterpret_cast<__eglMustCastToProperFunctionPointerType>(getQueryObjectui64v)},
+    };
+
+    for (const auto& f : FUNCTIONS) {
+        if (!std::strcmp(f.name, name))
+            return f.fn;
+    }
+    return nullptr;
+}
+}
@@ -0,0 +1,19 @@
+# Turns every file in SHADER_DIR into a string constant in OUTPUT, so the
+# plugin never reads GLSL from disk. glass.frag becomes SHADER_GLASS_FRAG.
+#
+# Usage: cmake -DSHADER_DIR=<dir> -DOUTPUT=<header> -P EmbedShaders.cmake
+
+file(GLOB SHADERS "${SHADER_DIR}/*.frag" "${SHADER_DIR}/*.vert")
+list(SORT SHADERS)
+
+set(CONTENT "#pragma once\n\n// Generated by cmake/EmbedShaders.cmake from shaders/, do not edit.\n")
+
+foreach(SHADER ${SHADERS})
+    get_filename_component(NAME "${SHADER}" NAME)
+    string(TOUPPER "${NAME}" NAME)
+    string(MAKE_C_IDENTIFIER "${NAME}" NAME)
+    file(READ "${SHADER}" SOURCE)
+    string(APPEND CONTENT "\ninline constexpr const char* SHADER_${NAME} = R\"glsl(${SOURCE})glsl\";\n")
+endforeach()
+
+file(WRITE "${OUTPUT}" "${CONTENT}")
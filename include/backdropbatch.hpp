@@ -0,0 +1,48 @@
+#pragma once
+
+#include "rect.hpp"
+
+#include <utility>
+#include <vector>
+
+// The glass windows of one monitor for one frame. In batched mode the plugin
+// blurs the union of their backdrops once and every window samples that
+// shared result, so blur cost follows covered screen area, not window count.
+// For now only the region is computed, the shared blur itself is a TODO in
+// glasswindow.cpp.
+class CBackdropBatch {
+  public:
+    void clear();
+    void addWindow(void* window, const SRect& box);
+
+    // Whether `window` is in the batch with exactly this box, i.e. the shared
+    // blur covers it
+    bool covers(void* window, const SRect& box) const;
+
+    bool empty() const {
+        return m_windows.empty();
+    }
+
+    // Biggest window box, the shared blur is planned for it
+    SRect largest() const;
+
+    // Disjoint rects covering every window box grown by `kernelRadius` and
+    // clipped to `bounds`. Valid until the next call or modification.
+    const std::vector<SRect>& region(int kernelRadius, const SRect& bounds);
+
+    // Area of region(), and of all window boxes counted separately
+    static long area(const std::vector<SRect>& rects);
+    long        windowArea() const;
+
+    // Smallest rect containing all of `rects`
+    static SRect bounds(const std::vector<SRect>& rects);
+
+  private:
+    std::vector<std::pair<void*, SRect>> m_windows;
+
+    // Scratch space, kept around so building the region doesn't allocate every frame
+    std::vector<SRect> m_region;
+    std::vector<SRect> m_grown;
+    std::vector<int>   m_edges;
+    std::vector<SRect> m_band;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "rect.hpp"
+
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+// Bookkeeping for the per-window blurred backdrop that is kept across frames.
+//
+// Each frame the renderer asks which parts of a window's backdrop have to be
+// blurred again. Damage is grown by the blur kernel footprint (a damaged pixel
+// bleeds into everything within that radius) and clipped to the window box;
+// an undamaged window is a hit and reuses its cached texture as-is. A window
+// whose box changed since the last frame is a miss and is redone in full.
+//
+// No framebuffer is kept yet (see the TODO in glasswindow.cpp), so the stats
+// count re-blurs the plugin would do, not ones it did.
+class CBackdropCache {
+  public:
+    enum eResult : uint8_t {
+        CACHE_HIT,     // nothing to redo
+        CACHE_PARTIAL, // redo the returned rects only
+        CACHE_MISS,    // redo the whole box
+    };
+
+    struct SStats {
+        uint64_t hits     = 0;
+        uint64_t partials = 0;
+        uint64_t misses   = 0;
+    };
+
+    // Fills `redo` (cleared first) with the rects of `box` that need a fresh
+    // blur this frame. `kernelRadius` is NBlur::footprint() of the current plan.
+    eResult update(void* window, const SRect& box, std::span<const SRect> damage, int kernelRadius, std::vector<SRect>& redo);
+
+    void    invalidate(void* window);
+    void    invalidateAll();
+
+    const SStats& stats() const {
+        return m_stats;
+    }
+    void resetStats() {
+        m_stats = {};
+    }
+
+  private:
+    struct SEntry {
+        SRect box;
+        bool  valid = false;
+    };
+
+    std::unordered_map<void*, SEntry> m_entries;
+    SStats                            m_stats;
+};
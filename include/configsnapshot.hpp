@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "blur.hpp"
+#include "governor.hpp"
+#include "rulematcher.hpp"
+
+// The plugin:glasswindow:* config compiled into one immutable object. Reload
+// builds a new snapshot and swaps a pointer to it; the render path reads
+// through that pointer and never parses, locks or allocates.
+//
+// Every rule can carry its own effect profile after `=>`:
+//
+//   plugin:glasswindow:rules = kitty => strength=0.4, alpha=0.95; ^Mozilla Firefox$ => chromatic=0; .*
+//
+// Keys are strength, blur_step, chromatic and alpha, standing for strength,
+// blur_step, chromatic_aberration and opacity, with the same 0-1 ranges. Keys
+// a rule leaves out, and rules without a profile, take the global values.
+namespace NConfig {
+
+    // One profile as glass.frag's `profile` vec4 wants it, upload as is
+    struct SEffectBlock {
+        float strength          = 0.f;
+        float chromaticStrength = 0.f; // 0 = off
+        float alpha             = 1.f;
+        float blurStep          = 0.f; // not read by glass.frag, for NBlur::planBlur
+    };
+    static_assert(sizeof(SEffectBlock) == 4 * sizeof(float), "SEffectBlock must stay a tightly packed vec4");
+
+    struct SProfile {
+        SEffectBlock        block;
+        NBlur::SGlassParams params; // same values, as the blur planner and governor take them
+    };
+
+    struct SSnapshot {
+        uint64_t                  generation = 0;
+
+        CRuleMatcher              rules;
+        std::vector<uint16_t>     ruleProfiles; // profile index per rule position
+        std::vector<SProfile>     profiles;     // [0] is the global one
+
+        // The profile with the widest blur, the shared blur of batched mode is planned for it
+        NBlur::SGlassParams       batchParams;
+
+        uint32_t                  distortionSeed = 0;
+        bool                      batch          = false;
+        bool                      stats          = false;
+        CQualityGovernor::SConfig governor;
+
+        // Profile index for a window title, -1 if no rule matches
+        int profileFor(std::string_view title) const {
+            const int rule = rules.firstMatch(title);
+            return rule < 0 ? -1 : ruleProfiles[rule];
+        }
+    };
+
+    // Returns the raw string value of a full config key name
+    using FGetValue = std::function<std::string(const std::string&)>;
+
+    // Read and validate every key. Returns nullptr if a value doesn't parse,
+    // the caller keeps its previous snapshot then. Problems are appended to
+    // `errors`; a bad rule only drops that rule.
+    std::unique_ptr<const SSnapshot> compile(const FGetValue& get, uint64_t generation, std::vector<std::string>& errors);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Tileable distortion field sampled by glass.frag instead of evaluating a
+// sin() hash per fragment. It is generated once (init / config reload) with
+// integer-only math, so a given seed gives the same bytes on every machine.
+namespace NDistortion {
+
+    constexpr int SIZE = 64; // texels per side
+    constexpr int CELL = 4;  // texels per noise lattice cell
+    constexpr int PERIOD = SIZE / CELL;
+
+    // Lattice cells per screen pixel, matches the old noise(uv * resolution * 0.5)
+    constexpr float CELLS_PER_PIXEL = 0.5f;
+
+    struct SField {
+        uint32_t             seed = 0;
+        std::vector<uint8_t> texels; // SIZE * SIZE RG8, x offset in R, y offset in G
+
+        // GL_LINEAR + GL_REPEAT lookup, returns both channels in 0-1
+        void sample(float u, float v, float& outX, float& outY) const;
+    };
+
+    SField generate(uint32_t seed);
+}
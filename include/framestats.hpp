@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+// Per-frame hot path counters, kept in a fixed ring of the last CAPACITY
+// frames. current() is filled during a frame and endFrame() publishes it.
+// Main thread only: Hyprland renders and runs hyprctl commands there, and
+// once the ring wraps endFrame() overwrites the slot json() reads first, so
+// a reader on another thread could see it half written.
+//
+// When disabled the plugin checks enabled() once per callback and records
+// nothing, so this can stay compiled into release builds.
+class CFrameStats {
+  public:
+    static constexpr size_t CAPACITY = 1024;
+
+    struct SFrame {
+        uint64_t callbackNs    = 0; // total time in renderWindow callbacks
+        uint64_t maxCallbackNs = 0; // slowest single callback
+        uint64_t ruleMatchNs   = 0; // part of callbackNs spent deciding whether to apply
+        uint32_t windows       = 0; // renderWindow callbacks
+        uint32_t glassWindows  = 0; // windows the effect was applied to
+        uint32_t plannedPasses = 0; // GPU passes the effect needs, the draws aren't issued yet
+    };
+
+    bool enabled() const {
+        return m_enabled;
+    }
+    void setEnabled(bool enabled) {
+        m_enabled = enabled;
+    }
+
+    SFrame& current() {
+        return m_current;
+    }
+    void endFrame();
+
+    // Forget everything recorded so far
+    void reset();
+
+    // Percentiles, max and a log2 histogram per counter over the retained frames
+    std::string json() const;
+
+  private:
+    std::array<SFrame, CAPACITY> m_ring;
+    SFrame                       m_current;
+
+    uint64_t                     m_published = 0; // frames ever published
+    uint64_t                     m_resetAt   = 0; // m_published at the last reset()
+    bool                         m_enabled   = false;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+#include "blur.hpp"
+
+// Adaptive quality for the glass effect. Fed the plugin's cost for every
+// frame (the larger of its CPU time and the GPU time of its passes, see
+// gputimer.hpp) against the monitor's frame budget, it steps the quality down
+// after a few frames over `degradeAt` and back up only after a longer run
+// under `restoreAt`, so it settles instead of flapping between two levels.
+// Costs are smoothed first, one slow frame in a calm run doesn't reset the
+// count. After every step the average is rebuilt from the new level's own
+// frames, so the old level's cost can't push it further down.
+//
+// The gap alone doesn't help when one level costs more than `degradeAt` and
+// the next one less than `restoreAt`. A restore that has to be undone before
+// it held for `restoreFrames` doubles the run the next restore needs, up to
+// `maxRestoreBackoff` times; a restore that holds resets it.
+//
+// Pure logic, no clock or GL: a timing trace in, a level out.
+class CQualityGovernor {
+  public:
+    enum eLevel : uint8_t {
+        QUALITY_FULL = 0,
+        QUALITY_CHEAP_TAPS,   // 4-tap upsample, no distortion
+        QUALITY_NO_CHROMATIC, // ...and no chromatic aberration
+        QUALITY_FOCUSED_ONLY, // ...and plain alpha for unfocused windows
+        QUALITY_ALPHA,        // plain alpha everywhere
+        QUALITY_LEVELS,
+    };
+
+    struct SConfig {
+        bool  enabled           = true;
+        float degradeAt         = 0.25f; // share of the frame budget
+        float restoreAt         = 0.10f;
+        int   degradeFrames     = 3;     // consecutive frames over degradeAt to step down
+        int   restoreFrames     = 60;    // consecutive frames under restoreAt to step up
+        long  tinyWindowArea    = 40000; // px, below this windows get plain alpha once degraded
+        float smoothing         = 0.1f;  // weight of the newest frame in the moving average
+        int   settleFrames      = 8;     // frames after a step that only measure the new level
+        int   maxRestoreBackoff = 64;    // most failed restores can stretch restoreFrames by
+    };
+
+    void setConfig(const SConfig& config);
+
+    const SConfig& config() const {
+        return m_config;
+    }
+
+    bool enabled() const {
+        return m_config.enabled;
+    }
+
+    // Feed one frame. Returns true if the level changed.
+    bool   onFrame(uint64_t costNs, uint64_t budgetNs);
+
+    eLevel level() const {
+        return m_level;
+    }
+
+    // Back to full quality, e.g. after a config reload
+    void reset();
+
+    // Effect parameters for one window at the current level
+    NBlur::SGlassParams paramsFor(const NBlur::SGlassParams& base, bool focused, long area) const {
+        return paramsAt(base, m_level, focused, area < m_config.tinyWindowArea);
+    }
+
+    static NBlur::SGlassParams paramsAt(const NBlur::SGlassParams& base, eLevel level, bool focused, bool tiny);
+
+  private:
+    SConfig m_config;
+    eLevel  m_level      = QUALITY_FULL;
+    double  m_share      = 0.0; // smoothed share of the frame budget
+    int     m_overRun    = 0;
+    int     m_underRun   = 0;
+    int     m_settleLeft = 0;   // frames left in the settle window
+    double  m_settleSum  = 0.0; // shares seen in it
+    int     m_restoreBackoff = 1; // restoreFrames multiplier, doubled per failed restore
+    int     m_probeLeft      = 0; // frames a fresh restore still has to hold, 0 = not probing
+
+    void    step(int direction);
+};
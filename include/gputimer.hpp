@@ -0,0 +1,65 @@
+#pragma once
+
+#include <GLES3/gl32.h>
+#include <GLES2/gl2ext.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// GPU time of the glass passes, for the quality governor. The blur and glass
+// draws are only queued by the renderWindow callback, so its CPU time says
+// nothing about whether a weak GPU gets them done before vblank. Each window's
+// passes are wrapped in a GL_EXT_disjoint_timer_query query instead, and a
+// frame's queries are read back once the GPU is done with them, a couple of
+// frames later, so reading never stalls the pipeline.
+//
+// Without the extension supported() is false and nothing is recorded.
+class CGpuTimer {
+  public:
+    static constexpr size_t FRAMES_IN_FLIGHT  = 3;
+    static constexpr size_t QUERIES_PER_FRAME = 64; // windows past this go unmeasured
+
+    // Needs a current GL context
+    void init();
+    void destroy();
+
+    bool supported() const {
+        return m_supported;
+    }
+
+    // Recording is skipped while disabled, e.g. with the governor off
+    void setEnabled(bool enabled) {
+        m_enabled = enabled;
+    }
+
+    // Around one window's passes, calls must not nest
+    void begin();
+    void end();
+
+    // Closes the current frame. Returns true and sets `gpuNs` to the total of
+    // the oldest frame in flight if its results are in and valid.
+    bool endFrame(uint64_t& gpuNs);
+
+  private:
+    struct SFrame {
+        std::array<GLuint, QUERIES_PER_FRAME> queries{};
+        size_t                                used    = 0;
+        bool                                  pending = false; // queries issued, not read back yet
+    };
+
+    std::array<SFrame, FRAMES_IN_FLIGHT> m_frames;
+    size_t                               m_current   = 0;
+    bool                                 m_supported = false;
+    bool                                 m_enabled   = false;
+    bool                                 m_open      = false; // begin() without end() yet
+
+    PFNGLGENQUERIESEXTPROC               m_genQueries          = nullptr;
+    PFNGLDELETEQUERIESEXTPROC            m_deleteQueries       = nullptr;
+    PFNGLBEGINQUERYEXTPROC               m_beginQuery          = nullptr;
+    PFNGLENDQUERYEXTPROC                 m_endQuery            = nullptr;
+    PFNGLGETQUERYOBJECTUIVEXTPROC        m_getQueryObjectuiv   = nullptr;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC      m_getQueryObjectui64v = nullptr;
+
+    bool                                 collect(SFrame& frame, uint64_t& gpuNs);
+};
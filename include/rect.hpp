@@ -0,0 +1,32 @@
+#pragma once
+
+#include <algorithm>
+
+// Integer pixel rectangle in layout coordinates
+struct SRect {
+    int x = 0, y = 0, w = 0, h = 0;
+
+    bool empty() const {
+        return w <= 0 || h <= 0;
+    }
+
+    SRect intersection(const SRect& o) const {
+        const int x1 = std::max(x, o.x), y1 = std::max(y, o.y);
+        const int x2 = std::min(x + w, o.x + o.w), y2 = std::min(y + h, o.y + o.h);
+        return {x1, y1, std::max(x2 - x1, 0), std::max(y2 - y1, 0)};
+    }
+
+    SRect expanded(int by) const {
+        return {x - by, y - by, w + 2 * by, h + 2 * by};
+    }
+
+    bool contains(const SRect& o) const {
+        return o.x >= x && o.y >= y && o.x + o.w <= x + w && o.y + o.h <= y + h;
+    }
+
+    long area() const {
+        return empty() ? 0 : static_cast<long>(w) * h;
+    }
+
+    bool operator==(const SRect&) const = default;
+};
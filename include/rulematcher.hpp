@@ -0,0 +1,66 @@
+#pragma once
+
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Compiled form of the semicolon-separated `plugin:glasswindow:rules` list.
+//
+// Rules that are plain text (optionally anchored with ^ / $) are matched with a
+// case-insensitive literal compare; ".*" and empty rules short-circuit to
+// "match everything". Regex rules with a literal every match has to contain
+// ("fire" in "fire(fox|dragon)") only run their regex when that literal is
+// in the title. Whatever is left is folded into a single alternation regex,
+// except rules with backreferences, whose group numbers it would shift.
+//
+// Rules are numbered by their position in the list, invalid ones included, so
+// firstMatch() can tell which rule a title matched first.
+class CRuleMatcher {
+  public:
+    // Compile `rulesRaw`, replacing any previous state. Rules that fail to
+    // compile are skipped and appended to `invalidRules` if given.
+    void compile(const std::string& rulesRaw, std::vector<std::string>* invalidRules = nullptr);
+
+    bool matches(std::string_view title) const;
+
+    // Position of the first rule in list order that matches `title`, -1 if none
+    int  firstMatch(std::string_view title) const;
+
+    size_t ruleCount() const {
+        return m_ruleCount;
+    }
+
+  private:
+    enum class eLiteralAnchor {
+        NONE,  // substring
+        START, // ^literal
+        END,   // literal$
+        FULL,  // ^literal$
+    };
+
+    struct SLiteralRule {
+        std::string    text; // lowercased
+        eLiteralAnchor anchor = eLiteralAnchor::NONE;
+        size_t         index  = 0;
+    };
+
+    struct SRegexRule {
+        std::string needle; // lowercased literal any match contains, empty = always run
+        std::regex  re;
+        size_t      index = 0;
+    };
+
+    static bool                        literalMatches(const SLiteralRule& rule, std::string_view title);
+    static std::optional<SLiteralRule> asLiteral(std::string_view rule);
+    static std::string                 requiredLiteral(std::string_view rule);
+
+    bool                      m_matchAll      = false;
+    size_t                    m_matchAllIndex = std::string::npos; // first ".*" / empty rule
+    size_t                    m_ruleCount     = 0;
+    std::vector<SLiteralRule> m_literals;
+    std::vector<SRegexRule>   m_regexes;
+    std::vector<SRegexRule>   m_unneedled; // regex rules without a needle, one by one for firstMatch()
+    std::optional<std::regex> m_combined;  // m_unneedled as one alternation
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <GLES3/gl32.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "shaders.hpp"
+
+// A linked program and the locations it was queried for. Locations a
+// variant doesn't use are -1, which glUniform* silently ignores.
+struct SGlassProgram {
+    GLuint id = 0;
+
+    GLint  proj              = -1;
+    GLint  posAttrib         = -1;
+    GLint  texAttrib         = -1;
+
+    GLint  tex               = -1;
+    GLint  profile           = -1; // vec4, one NConfig::SEffectBlock
+    GLint  resolution        = -1;
+    GLint  blurTex           = -1;
+    GLint  blurTexel         = -1;
+    GLint  blurOffset        = -1;
+    GLint  distortionTex     = -1;
+
+    // blur_down / blur_up
+    GLint texel  = -1;
+    GLint offset = -1;
+};
+
+// Programs keyed by NShaders::SVariant::key(). Filled at init / config reload,
+// the render path only looks programs up. Needs a current GL context for
+// build() and destroy().
+class CShaderCache {
+  public:
+    // Compile and link `variant` unless it is cached already. Returns nullptr
+    // and fills `error` with the GL info log on failure.
+    const SGlassProgram* build(const NShaders::SVariant& variant, std::string* error = nullptr);
+
+    const SGlassProgram* get(const NShaders::SVariant& variant) const;
+
+    void                 destroy();
+
+    size_t               size() const {
+        return m_programs.size();
+    }
+
+  private:
+    std::unordered_map<uint32_t, SGlassProgram> m_programs;
+};
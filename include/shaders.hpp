@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "blur.hpp"
+
+// Specialized shader variants. Everything that used to be a uniform branch in
+// glass.frag is a preprocessor define here, so each program the plugin draws
+// with is straight-line code. The GLSL itself is embedded at build time
+// (cmake/EmbedShaders.cmake).
+namespace NShaders {
+
+    enum eProgram : uint8_t {
+        PROGRAM_GLASS = 0,
+        PROGRAM_BLUR_DOWN,
+        PROGRAM_BLUR_UP,
+    };
+
+    struct SVariant {
+        eProgram program    = PROGRAM_GLASS;
+        bool     blur       = false;
+        bool     distortion = false;
+        bool     chromatic  = false;
+        bool     alphaOnly  = false;
+        uint8_t  upTaps     = 0; // 0 when no upsample taps are taken
+
+        // Packed bits, used as the program cache key
+        uint32_t key() const;
+
+        bool     operator==(const SVariant&) const = default;
+    };
+
+    // Glass pass variant for `params`. Only the parts of the config that
+    // change the generated code end up in it, so configs that differ in plain
+    // uniform values (alpha, offsets...) share a program.
+    SVariant              glassVariant(const NBlur::SGlassParams& params);
+
+    // Every program needed to draw with `params`: the glass pass plus the
+    // blur chain passes when it blurs at all.
+    std::vector<SVariant> variantsFor(const NBlur::SGlassParams& params);
+
+    std::string           fragmentSource(const SVariant& variant);
+    const char*           vertexSource();
+}
@@ -0,0 +1,21 @@
+#version 300 es
+precision highp float;
+
+// Dual-Kawase downsample pass, renders at half the resolution of `tex`
+uniform sampler2D tex;
+uniform vec2 texel;            // 1.0 / source size
+uniform float offset;          // sample offset in source texels
+in vec2 v_texcoord;
+out vec4 fragColor;
+
+void main() {
+    vec2 h = texel * offset;
+
+    vec4 sum = texture(tex, v_texcoord) * 4.0;
+    sum += texture(tex, v_texcoord - h);
+    sum += texture(tex, v_texcoord + h);
+    sum += texture(tex, v_texcoord + vec2(h.x, -h.y));
+    sum += texture(tex, v_texcoord - vec2(h.x, -h.y));
+
+    fragColor = sum / 8.0;
+}
@@ -0,0 +1,38 @@
+#version 300 es
+precision highp float;
+
+// Dual-Kawase upsample pass, renders at twice the resolution of `tex`
+uniform sampler2D tex;
+uniform vec2 texel;            // 1.0 / source size
+uniform float offset;          // sample offset in source texels
+in vec2 v_texcoord;
+out vec4 fragColor;
+
+#ifndef UP_TAPS
+#define UP_TAPS 8
+#endif
+
+void main() {
+    vec2 h = texel * offset * 0.5;
+
+#if UP_TAPS == 8
+    vec4 sum = texture(tex, v_texcoord + vec2(-h.x * 2.0, 0.0));
+    sum += texture(tex, v_texcoord + vec2(h.x * 2.0, 0.0));
+    sum += texture(tex, v_texcoord + vec2(0.0, -h.y * 2.0));
+    sum += texture(tex, v_texcoord + vec2(0.0, h.y * 2.0));
+    sum += texture(tex, v_texcoord + vec2(-h.x, h.y)) * 2.0;
+    sum += texture(tex, v_texcoord + vec2(h.x, h.y)) * 2.0;
+    sum += texture(tex, v_texcoord + vec2(-h.x, -h.y)) * 2.0;
+    sum += texture(tex, v_texcoord + vec2(h.x, -h.y)) * 2.0;
+
+    fragColor = sum / 12.0;
+#else
+    // Cheap variant: diagonal taps only
+    vec4 sum = texture(tex, v_texcoord + vec2(-h.x, h.y));
+    sum += texture(tex, v_texcoord + vec2(h.x, h.y));
+    sum += texture(tex, v_texcoord + vec2(-h.x, -h.y));
+    sum += texture(tex, v_texcoord + vec2(h.x, -h.y));
+
+    fragColor = sum / 4.0;
+#endif
+}
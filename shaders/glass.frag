@@ -1,71 +1,87 @@
 #version 300 es
 precision highp float;
 
-uniform sampler2D tex;
-uniform float alpha;
-uniform float strength;        // overall glass strength (0-1)
-uniform float blur_step;       // UV step size for blur sampling
-uniform int chromatic;         // 0 = off, 1 = on
-uniform float chromatic_strength; // chromatic aberration offset
+// Final pass of the blur chain: upsamples the last blur level back to full
+// resolution and applies distortion, chromatic aberration and alpha once.
+//
+// Built in variants (see shaders.hpp), the features are compile-time defines:
+//   BLUR        sample the blur chain and mix it in by strength
+//   DISTORTION  offset the blur lookup by distortionTex (needs BLUR)
+//   CHROMATIC   chromatic aberration
+//   ALPHA_ONLY  strength == 0 fast path, just tex * alpha
+//   UP_TAPS     8 = full dual-Kawase upsample, 4 = diagonal taps only
+uniform sampler2D tex;         // original window contents
+uniform sampler2D blurTex;     // half resolution output of the blur chain
+uniform vec2 blurTexel;        // 1.0 / blurTex size
+uniform float blurOffset;      // sample offset in blurTex texels
+uniform vec4 profile;          // strength (0-1), chromatic offset, alpha, blur_step (NConfig::SEffectBlock)
 uniform vec2 resolution;       // viewport size (for distortion scale)
+uniform sampler2D distortionTex; // tileable RG8 distortion field, GL_REPEAT (distortion.hpp)
 in vec2 v_texcoord;
 out vec4 fragColor;
 
-// Simple pseudo-random noise based on UV coords
-float rand(vec2 co) {
-    return fract(sin(dot(co.xy, vec2(12.9898,78.233))) * 43758.5453);
-}
+#ifndef UP_TAPS
+#define UP_TAPS 8
+#endif
 
-// 2D noise for distortion offset
-float noise(vec2 p) {
-    vec2 i = floor(p);
-    vec2 f = fract(p);
-    float a = rand(i);
-    float b = rand(i + vec2(1.0, 0.0));
-    float c = rand(i + vec2(0.0, 1.0));
-    float d = rand(i + vec2(1.0, 1.0));
-    vec2 u = f*f*(3.0 - 2.0*f);
-    return mix(a, b, u.x) + (c - a)* u.y * (1.0 - u.x) + (d - b) * u.x * u.y;
-}
+// Noise lattice cells covered by one tile of distortionTex (NDistortion::PERIOD)
+const float DISTORTION_PERIOD = 16.0;
 
 void main() {
-    // Calculate distortion offset
-    float distortion_strength = strength * 0.02;
-    vec2 distortion = vec2(
-        noise(v_texcoord * resolution.xy * 0.5),
-        noise(v_texcoord * resolution.xy * 0.5 + 100.0)
-    ) * distortion_strength;
+    float strength = profile.x;
+    float chromatic_strength = profile.y;
+    float alpha = profile.z;
 
-    // Accumulate blur color with offset distortion
-    vec4 blurColor = vec4(0.0);
-    float total = 0.0;
+#ifdef ALPHA_ONLY
+    fragColor = texture(tex, v_texcoord);
+    fragColor.a *= alpha;
+#else
+    // Original color
+    vec4 color = texture(tex, v_texcoord);
 
-    for (int x = -2; x <= 2; x++) {
-        for (int y = -2; y <= 2; y++) {
-            vec2 offset = vec2(float(x), float(y)) * blur_step + distortion;
-            blurColor += texture(tex, v_texcoord + offset);
-            total += 1.0;
-        }
-    }
-    blurColor /= total;
+#ifdef BLUR
+    vec2 uv = v_texcoord;
 
-    // Original color
-    vec4 origColor = texture(tex, v_texcoord);
+#ifdef DISTORTION
+    // Calculate distortion offset
+    float distortion_strength = strength * 0.02;
+    uv += texture(distortionTex, v_texcoord * resolution.xy * 0.5 / DISTORTION_PERIOD).rg * distortion_strength;
+#endif
+
+    // Dual-Kawase upsample of the blur chain, sampled through the distortion
+    vec2 h = blurTexel * blurOffset * 0.5;
+#if UP_TAPS == 8
+    vec4 blurColor = texture(blurTex, uv + vec2(-h.x * 2.0, 0.0));
+    blurColor += texture(blurTex, uv + vec2(h.x * 2.0, 0.0));
+    blurColor += texture(blurTex, uv + vec2(0.0, -h.y * 2.0));
+    blurColor += texture(blurTex, uv + vec2(0.0, h.y * 2.0));
+    blurColor += texture(blurTex, uv + vec2(-h.x, h.y)) * 2.0;
+    blurColor += texture(blurTex, uv + vec2(h.x, h.y)) * 2.0;
+    blurColor += texture(blurTex, uv + vec2(-h.x, -h.y)) * 2.0;
+    blurColor += texture(blurTex, uv + vec2(h.x, -h.y)) * 2.0;
+    blurColor /= 12.0;
+#else
+    vec4 blurColor = texture(blurTex, uv + vec2(-h.x, h.y));
+    blurColor += texture(blurTex, uv + vec2(h.x, h.y));
+    blurColor += texture(blurTex, uv + vec2(-h.x, -h.y));
+    blurColor += texture(blurTex, uv + vec2(h.x, -h.y));
+    blurColor /= 4.0;
+#endif
 
     // Mix original and blurred with strength
-    vec4 color = mix(origColor, blurColor, strength);
+    color = mix(color, blurColor, strength);
+#endif
 
+#ifdef CHROMATIC
     // Chromatic aberration
-    if (chromatic == 1) {
-        vec2 chromaOffset = vec2(chromatic_strength);
-        vec4 r = texture(tex, v_texcoord + chromaOffset);
-        vec4 b = texture(tex, v_texcoord - chromaOffset);
-        color.r = r.r;
-        color.b = b.b;
-    }
+    vec2 chromaOffset = vec2(chromatic_strength);
+    color.r = texture(tex, v_texcoord + chromaOffset).r;
+    color.b = texture(tex, v_texcoord - chromaOffset).b;
+#endif
 
     // Apply alpha
     color.a *= alpha;
 
     fragColor = color;
+#endif
 }
@@ -0,0 +1,12 @@
+#version 300 es
+
+// Shared by every glasswindow program
+uniform mat3 proj;
+in vec2 pos;
+in vec2 texcoord;
+out vec2 v_texcoord;
+
+void main() {
+    gl_Position = vec4(proj * vec3(pos, 1.0), 1.0);
+    v_texcoord = texcoord;
+}
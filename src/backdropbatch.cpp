@@ -0,0 +1,114 @@
+#include "backdropbatch.hpp"
+
+#include <algorithm>
+
+void CBackdropBatch::clear() {
+    m_windows.clear();
+}
+
+void CBackdropBatch::addWindow(void* window, const SRect& box) {
+    m_windows.emplace_back(window, box);
+}
+
+bool CBackdropBatch::covers(void* window, const SRect& box) const {
+    return std::find(m_windows.begin(), m_windows.end(), std::pair{window, box}) != m_windows.end();
+}
+
+SRect CBackdropBatch::largest() const {
+    SRect best;
+    for (const auto& [window, box] : m_windows) {
+        if (box.area() > best.area())
+            best = box;
+    }
+    return best;
+}
+
+const std::vector<SRect>& CBackdropBatch::region(int kernelRadius, const SRect& bounds) {
+    m_region.clear();
+    m_grown.clear();
+    m_edges.clear();
+
+    for (const auto& [window, box] : m_windows) {
+        const auto grown = box.expanded(kernelRadius).intersection(bounds);
+        if (grown.empty())
+            continue;
+        m_grown.push_back(grown);
+        m_edges.push_back(grown.y);
+        m_edges.push_back(grown.y + grown.h);
+    }
+
+    std::sort(m_edges.begin(), m_edges.end());
+    m_edges.erase(std::unique(m_edges.begin(), m_edges.end()), m_edges.end());
+
+    // Sweep horizontal bands between consecutive y edges. Inside a band the
+    // coverage is a set of x spans; identical spans in the band right above
+    // are extended instead of starting new rects.
+    size_t prevBandStart = 0;
+    for (size_t i = 0; i + 1 < m_edges.size(); ++i) {
+        const int y0 = m_edges[i], y1 = m_edges[i + 1];
+
+        m_band.clear();
+        for (const auto& rect : m_grown) {
+            if (rect.y <= y0 && rect.y + rect.h >= y1)
+                m_band.push_back({rect.x, y0, rect.w, y1 - y0});
+        }
+
+        std::sort(m_band.begin(), m_band.end(), [](const SRect& a, const SRect& b) { return a.x < b.x; });
+
+        // Merge overlapping / touching spans
+        size_t merged = 0;
+        for (size_t j = 0; j < m_band.size(); ++j) {
+            if (merged && m_band[merged - 1].x + m_band[merged - 1].w >= m_band[j].x) {
+                auto& last = m_band[merged - 1];
+                last.w     = std::max(last.x + last.w, m_band[j].x + m_band[j].w) - last.x;
+            } else
+                m_band[merged++] = m_band[j];
+        }
+        m_band.resize(merged);
+
+        // Same spans as the previous band and directly below it: grow those rects down
+        const size_t prevCount = m_region.size() - prevBandStart;
+        const bool   extend    = prevCount == m_band.size() && prevCount > 0 && m_region[prevBandStart].y + m_region[prevBandStart].h == y0 &&
+            std::equal(m_band.begin(), m_band.end(), m_region.begin() + prevBandStart, [](const SRect& a, const SRect& b) { return a.x == b.x && a.w == b.w; });
+
+        if (extend) {
+            for (size_t j = prevBandStart; j < m_region.size(); ++j)
+                m_region[j].h += y1 - y0;
+            continue;
+        }
+
+        prevBandStart = m_region.size();
+        m_region.insert(m_region.end(), m_band.begin(), m_band.end());
+    }
+
+    return m_region;
+}
+
+long CBackdropBatch::area(const std::vector<SRect>& rects) {
+    long total = 0;
+    for (const auto& rect : rects)
+        total += rect.area();
+    return total;
+}
+
+SRect CBackdropBatch::bounds(const std::vector<SRect>& rects) {
+    if (rects.empty())
+        return {};
+
+    int x1 = rects.front().x, y1 = rects.front().y;
+    int x2 = x1 + rects.front().w, y2 = y1 + rects.front().h;
+    for (const auto& rect : rects) {
+        x1 = std::min(x1, rect.x);
+        y1 = std::min(y1, rect.y);
+        x2 = std::max(x2, rect.x + rect.w);
+        y2 = std::max(y2, rect.y + rect.h);
+    }
+    return {x1, y1, x2 - x1, y2 - y1};
+}
+
+long CBackdropBatch::windowArea() const {
+    long total = 0;
+    for (const auto& [window, box] : m_windows)
+        total += box.area();
+    return total;
+}
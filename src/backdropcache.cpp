@@ -0,0 +1,45 @@
+#include "backdropcache.hpp"
+
+CBackdropCache::eResult CBackdropCache::update(void* window, const SRect& box, std::span<const SRect> damage, int kernelRadius, std::vector<SRect>& redo) {
+    redo.clear();
+
+    auto& entry = m_entries[window];
+    if (!entry.valid || entry.box != box) {
+        entry.box   = box;
+        entry.valid = true;
+        redo.push_back(box);
+        m_stats.misses++;
+        return CACHE_MISS;
+    }
+
+    for (const auto& rect : damage) {
+        const auto dirty = rect.expanded(kernelRadius).intersection(box);
+        if (dirty.empty())
+            continue;
+
+        // Damage covering the whole window is just a miss by another name
+        if (dirty == box) {
+            redo.assign(1, box);
+            m_stats.misses++;
+            return CACHE_MISS;
+        }
+
+        redo.push_back(dirty);
+    }
+
+    if (redo.empty()) {
+        m_stats.hits++;
+        return CACHE_HIT;
+    }
+
+    m_stats.partials++;
+    return CACHE_PARTIAL;
+}
+
+void CBackdropCache::invalidate(void* window) {
+    m_entries.erase(window);
+}
+
+void CBackdropCache::invalidateAll() {
+    m_entries.clear();
+}
@@ -0,0 +1,201 @@
+#include "blur.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace NBlur {
+
+    namespace {
+
+        SPixel texel(const SImage& img, int x, int y) {
+            return img.at(std::clamp(x, 0, img.width - 1), std::clamp(y, 0, img.height - 1));
+        }
+
+        // dual-Kawase upsample filter, see blur_up.frag
+        SPixel upFilter(const SImage& src, float u, float v, float offset, int taps) {
+            const float hx = 0.5f * offset / src.width;
+            const float hy = 0.5f * offset / src.height;
+
+            if (taps == UP_TAPS_CHEAP) {
+                SPixel sum = src.sample(u - hx, v + hy);
+                sum += src.sample(u + hx, v + hy);
+                sum += src.sample(u - hx, v - hy);
+                sum += src.sample(u + hx, v - hy);
+                return sum * 0.25f;
+            }
+
+            SPixel sum = src.sample(u - 2.f * hx, v);
+            sum += src.sample(u + 2.f * hx, v);
+            sum += src.sample(u, v - 2.f * hy);
+            sum += src.sample(u, v + 2.f * hy);
+            sum += src.sample(u - hx, v + hy) * 2.f;
+            sum += src.sample(u + hx, v + hy) * 2.f;
+            sum += src.sample(u - hx, v - hy) * 2.f;
+            sum += src.sample(u + hx, v - hy) * 2.f;
+            return sum * (1.f / 12.f);
+        }
+
+    } // namespace
+
+    SPixel SImage::sample(float u, float v) const {
+        const float x  = u * width - 0.5f;
+        const float y  = v * height - 0.5f;
+        const float x0 = std::floor(x), y0 = std::floor(y);
+        const float fx = x - x0, fy = y - y0;
+        const int   ix = static_cast<int>(x0), iy = static_cast<int>(y0);
+
+        SPixel      top = texel(*this, ix, iy) * (1.f - fx);
+        top += texel(*this, ix + 1, iy) * fx;
+        SPixel bottom = texel(*this, ix, iy + 1) * (1.f - fx);
+        bottom += texel(*this, ix + 1, iy + 1) * fx;
+
+        SPixel out = top * (1.f - fy);
+        out += bottom * fy;
+        return out;
+    }
+
+    SBlurPlan planBlur(const SGlassParams& params, int width, int height) {
+        SBlurPlan plan;
+
+        const float radius = 2.f * params.blur_step * params.strength * std::max(width, height);
+        if (radius <= 0.f || width < 2 || height < 2)
+            return plan;
+
+        // Each down/up level roughly doubles the reach of the kernel
+        int passes = std::clamp(static_cast<int>(std::ceil(std::log2(std::max(radius, 1.f)))) - 1, 1, MAX_PASSES);
+        while (passes > 1 && ((width >> passes) < 1 || (height >> passes) < 1))
+            passes--;
+
+        plan.passes = passes;
+        plan.offset = std::clamp(radius / static_cast<float>(1 << (passes + 1)), 0.5f, 4.f);
+        return plan;
+    }
+
+    int footprint(const SBlurPlan& plan) {
+        if (plan.passes <= 0)
+            return 0;
+
+        // Level i reaches offset (+1 for the bilinear footprint) texels of its
+        // source, which are 2^i full resolution pixels; down and up both do it.
+        // Upsample taps reach one level further, so round up to 2^(passes+1).
+        return static_cast<int>(std::ceil(2.f * (plan.offset + 1.f) * ((1 << (plan.passes + 1)) - 1)));
+    }
+
+    SImage downsample(const SImage& src, float offset, SPassCost* cost) {
+        SImage dst(std::max(src.width / 2, 1), std::max(src.height / 2, 1));
+
+        const float hx = offset / src.width;
+        const float hy = offset / src.height;
+
+        for (int y = 0; y < dst.height; ++y) {
+            for (int x = 0; x < dst.width; ++x) {
+                const float u = (x + 0.5f) / dst.width;
+                const float v = (y + 0.5f) / dst.height;
+
+                SPixel      sum = src.sample(u, v) * 4.f;
+                sum += src.sample(u - hx, v - hy);
+                sum += src.sample(u + hx, v + hy);
+                sum += src.sample(u + hx, v - hy);
+                sum += src.sample(u - hx, v + hy);
+                dst.at(x, y) = sum * (1.f / 8.f);
+            }
+        }
+
+        if (cost)
+            *cost = {"down", dst.width, dst.height, static_cast<uint64_t>(dst.width) * dst.height * DOWN_TAPS};
+
+        return dst;
+    }
+
+    SImage upsample(const SImage& src, int width, int height, float offset, int taps, SPassCost* cost) {
+        SImage dst(width, height);
+
+        for (int y = 0; y < dst.height; ++y) {
+            for (int x = 0; x < dst.width; ++x) {
+                dst.at(x, y) = upFilter(src, (x + 0.5f) / dst.width, (y + 0.5f) / dst.height, offset, taps);
+            }
+        }
+
+        if (cost)
+            *cost = {"up", dst.width, dst.height, static_cast<uint64_t>(dst.width) * dst.height * taps};
+
+        return dst;
+    }
+
+    SImage composite(const SImage& orig, const SImage& blurred, const NDistortion::SField& distortion, const SGlassParams& params, float offset,
+                     SPassCost* cost) {
+        SImage      dst(orig.width, orig.height);
+
+        const float distortionStrength = params.strength * 0.02f;
+        const bool  alphaOnly          = params.strength <= 0.f;
+        const bool  blur               = !alphaOnly && !blurred.pixels.empty();
+        const bool  chromatic          = !alphaOnly && params.chromatic;
+        const bool  distort            = blur && params.distortion;
+
+        for (int y = 0; y < dst.height; ++y) {
+            for (int x = 0; x < dst.width; ++x) {
+                const float u = (x + 0.5f) / dst.width;
+                const float v = (y + 0.5f) / dst.height;
+
+                SPixel      color = orig.sample(u, v);
+
+                if (blur) {
+                    float du = 0.f, dv = 0.f;
+                    if (distort) {
+                        distortion.sample(u * orig.width * NDistortion::CELLS_PER_PIXEL / NDistortion::PERIOD,
+                                          v * orig.height * NDistortion::CELLS_PER_PIXEL / NDistortion::PERIOD, du, dv);
+                        du *= distortionStrength;
+                        dv *= distortionStrength;
+                    }
+
+                    const SPixel blurColor = upFilter(blurred, u + du, v + dv, offset, params.up_taps);
+                    color                  = color * (1.f - params.strength);
+                    color += blurColor * params.strength;
+                }
+
+                if (chromatic) {
+                    color.r = orig.sample(u + params.chromatic_strength, v + params.chromatic_strength).r;
+                    color.b = orig.sample(u - params.chromatic_strength, v - params.chromatic_strength).b;
+                }
+
+                color.a *= params.alpha;
+                dst.at(x, y) = color;
+            }
+        }
+
+        if (cost) {
+            const uint64_t taps = 1 + (blur ? params.up_taps : 0) + (distort ? 1 : 0) + (chromatic ? 2 : 0);
+            *cost               = {"composite", dst.width, dst.height, static_cast<uint64_t>(dst.width) * dst.height * taps};
+        }
+
+        return dst;
+    }
+
+    SImage run(const SImage& src, const SGlassParams& params, std::vector<SPassCost>* costs) {
+        const auto          plan = planBlur(params, src.width, src.height);
+
+        std::vector<SImage> levels;
+        levels.reserve(plan.passes);
+
+        SPassCost cost;
+        for (int i = 0; i < plan.passes; ++i) {
+            levels.emplace_back(downsample(i == 0 ? src : levels.back(), plan.offset, &cost));
+            if (costs)
+                costs->push_back(cost);
+        }
+
+        // Walk back up to level 1, level 0 is left to the composite pass
+        for (int i = plan.passes - 1; i > 0; --i) {
+            const auto& target = levels[i - 1];
+            levels[i - 1]      = upsample(levels[i], target.width, target.height, plan.offset, params.up_taps, &cost);
+            if (costs)
+                costs->push_back(cost);
+        }
+
+        auto out = composite(src, levels.empty() ? SImage{} : levels.front(), NDistortion::generate(params.distortion_seed), params, plan.offset, &cost);
+        if (costs)
+            costs->push_back(cost);
+
+        return out;
+    }
+}
@@ -0,0 +1,197 @@
+#include "configsnapshot.hpp"
+
+#include <algorithm>
+#include <charconv>
+
+namespace NConfig {
+
+    namespace {
+
+        constexpr const char* PREFIX = "plugin:glasswindow:";
+
+        std::string_view trim(std::string_view text) {
+            while (!text.empty() && (text.front() == ' ' || text.front() == '\t'))
+                text.remove_prefix(1);
+            while (!text.empty() && (text.back() == ' ' || text.back() == '\t'))
+                text.remove_suffix(1);
+            return text;
+        }
+
+        // Locale independent and without exceptions, unlike std::stof
+        template <typename T>
+        bool parse(std::string_view text, T& out) {
+            text = trim(text);
+            if (!text.empty() && text.front() == '+')
+                text.remove_prefix(1);
+            const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), out);
+            return ec == std::errc() && end == text.data() + text.size() && !text.empty();
+        }
+
+        class CReader {
+          public:
+            CReader(const FGetValue& get, std::vector<std::string>& errors) : m_get(get), m_errors(errors) {}
+
+            template <typename T>
+            T read(const char* key, T min, T max) {
+                const std::string name  = std::string(PREFIX) + key;
+                const std::string value = m_get(name);
+
+                T                 out{};
+                if (!parse(value, out) || out < min || out > max) {
+                    m_errors.push_back("Invalid value for " + name + ": \"" + value + "\"");
+                    m_failed = true;
+                }
+                return out;
+            }
+
+            std::string readString(const char* key) {
+                return m_get(std::string(PREFIX) + key);
+            }
+
+            bool failed() const {
+                return m_failed;
+            }
+
+          private:
+            const FGetValue&          m_get;
+            std::vector<std::string>& m_errors;
+            bool                      m_failed = false;
+        };
+
+        SProfile makeProfile(const SEffectBlock& block, uint32_t seed) {
+            return {
+                .block = block,
+                .params =
+                    {
+                        .strength           = block.strength,
+                        .blur_step          = block.blurStep,
+                        .chromatic          = block.chromaticStrength > 0.f,
+                        .chromatic_strength = block.chromaticStrength,
+                        .alpha              = block.alpha,
+                        .distortion_seed    = seed,
+                    },
+            };
+        }
+
+        // "strength=0.4, alpha=0.95" on top of `base`. Returns false on an
+        // unknown key or a bad value.
+        bool parseProfile(std::string_view text, SEffectBlock& block) {
+            while (true) {
+                const size_t comma = text.find(',');
+                const auto   entry = trim(text.substr(0, comma));
+
+                if (!entry.empty()) {
+                    const size_t eq = entry.find('=');
+                    if (eq == std::string_view::npos)
+                        return false;
+
+                    // Same ranges as the global keys they override
+                    const auto key = trim(entry.substr(0, eq));
+                    float      value;
+                    if (!parse(entry.substr(eq + 1), value) || value < 0.f || value > 1.f)
+                        return false;
+
+                    if (key == "strength")
+                        block.strength = value;
+                    else if (key == "alpha")
+                        block.alpha = value;
+                    else if (key == "blur_step")
+                        block.blurStep = value;
+                    else if (key == "chromatic")
+                        block.chromaticStrength = value;
+                    else
+                        return false;
+                }
+
+                if (comma == std::string_view::npos)
+                    return true;
+                text.remove_prefix(comma + 1);
+            }
+        }
+
+    } // namespace
+
+    std::unique_ptr<const SSnapshot> compile(const FGetValue& get, uint64_t generation, std::vector<std::string>& errors) {
+        auto    snapshot        = std::make_unique<SSnapshot>();
+        snapshot->generation    = generation;
+
+        CReader reader(get, errors);
+
+        SEffectBlock global;
+        global.strength          = reader.read("strength", 0.f, 1.f);
+        global.blurStep          = reader.read("blur_step", 0.f, 1.f);
+        global.chromaticStrength = reader.read("chromatic_aberration", 0.f, 1.f);
+        global.alpha             = reader.read("opacity", 0.f, 1.f);
+
+        snapshot->distortionSeed = reader.read("distortion_seed", 0u, UINT32_MAX);
+        snapshot->batch          = reader.read("batch", 0, 1) != 0;
+        snapshot->stats          = reader.read("stats", 0, 1) != 0;
+
+        auto& governor          = snapshot->governor;
+        governor.enabled        = reader.read("governor", 0, 1) != 0;
+        governor.degradeAt      = reader.read("governor_degrade_at", 0.f, 1.f);
+        governor.restoreAt      = reader.read("governor_restore_at", 0.f, 1.f);
+        governor.degradeFrames  = reader.read("governor_degrade_frames", 1, 10000);
+        governor.restoreFrames  = reader.read("governor_restore_frames", 1, 10000);
+        governor.tinyWindowArea = reader.read("governor_tiny_area", 0L, 1L << 40);
+
+        if (reader.failed())
+            return nullptr;
+
+        // Without a gap between the thresholds the governor can step down and
+        // back up on alternate runs
+        if (governor.restoreAt >= governor.degradeAt) {
+            errors.push_back(std::string("Invalid value for ") + PREFIX + "governor_restore_at: \"" + reader.readString("governor_restore_at") + "\", must be below governor_degrade_at");
+            return nullptr;
+        }
+
+        snapshot->profiles.push_back(makeProfile(global, snapshot->distortionSeed));
+
+        // Split profiles off the rules, the matcher only sees the patterns.
+        // Positions are kept, so rule i of the matcher is entry i here. The
+        // blanks around `;` are for readability, not part of the pattern,
+        // and trimming them keeps " .*" on the matcher's match-all path.
+        const std::string rulesRaw = reader.readString("rules");
+        std::string       patterns;
+
+        size_t            start = 0;
+        while (true) {
+            const size_t end   = rulesRaw.find(';', start);
+            auto         entry = trim(std::string_view(rulesRaw).substr(start, (end == std::string::npos ? rulesRaw.size() : end) - start));
+
+            uint16_t     profile = 0;
+            if (const size_t arrow = entry.find("=>"); arrow != std::string_view::npos) {
+                SEffectBlock block = global;
+                if (parseProfile(entry.substr(arrow + 2), block) && snapshot->profiles.size() <= UINT16_MAX) {
+                    profile = static_cast<uint16_t>(snapshot->profiles.size());
+                    snapshot->profiles.push_back(makeProfile(block, snapshot->distortionSeed));
+                    entry = trim(entry.substr(0, arrow));
+                } else {
+                    errors.push_back("Invalid profile in rules: " + std::string(entry));
+                    // Can't be matched by a title, keeps the positions lined up
+                    entry = "[^\\s\\S]";
+                }
+            }
+
+            if (start)
+                patterns += ';';
+            patterns += entry;
+            snapshot->ruleProfiles.push_back(profile);
+
+            if (end == std::string::npos)
+                break;
+            start = end + 1;
+        }
+
+        std::vector<std::string> invalidRules;
+        snapshot->rules.compile(patterns, &invalidRules);
+        for (const auto& rule : invalidRules)
+            errors.push_back("Invalid regex in rules: " + rule);
+
+        const auto widest = std::max_element(snapshot->profiles.begin(), snapshot->profiles.end(),
+                                             [](const SProfile& a, const SProfile& b) { return a.block.strength * a.block.blurStep < b.block.strength * b.block.blurStep; });
+        snapshot->batchParams = widest->params;
+
+        return snapshot;
+    }
+}
@@ -0,0 +1,91 @@
+#include "distortion.hpp"
+
+#include <cmath>
+
+namespace NDistortion {
+
+    namespace {
+
+        // lowbias32 integer hash
+        uint32_t hash(uint32_t x) {
+            x ^= x >> 16;
+            x *= 0x7feb352dU;
+            x ^= x >> 15;
+            x *= 0x846ca68bU;
+            x ^= x >> 16;
+            return x;
+        }
+
+        uint32_t lattice(int x, int y, uint32_t seed) {
+            // Wrapping the lattice makes the field tile
+            x = (x % PERIOD + PERIOD) % PERIOD;
+            y = (y % PERIOD + PERIOD) % PERIOD;
+            return hash(static_cast<uint32_t>(x) + hash(static_cast<uint32_t>(y) + hash(seed))) & 0xFF;
+        }
+
+        // smoothstep of f / CELL in 16.16 fixed point
+        int64_t fade(int f) {
+            const int64_t t = (static_cast<int64_t>(f) << 16) / CELL;
+            return (t * t * ((3 << 16) - 2 * t)) >> 32;
+        }
+
+        uint8_t valueNoise(int tx, int ty, uint32_t seed) {
+            const int     cx = tx / CELL, cy = ty / CELL;
+            const int64_t ux = fade(tx % CELL), uy = fade(ty % CELL);
+
+            const int64_t a = lattice(cx, cy, seed);
+            const int64_t b = lattice(cx + 1, cy, seed);
+            const int64_t c = lattice(cx, cy + 1, seed);
+            const int64_t d = lattice(cx + 1, cy + 1, seed);
+
+            const int64_t top    = (a << 16) + (b - a) * ux;
+            const int64_t bottom = (c << 16) + (d - c) * ux;
+            return static_cast<uint8_t>(((top << 16) + (bottom - top) * uy) >> 32);
+        }
+
+        uint8_t texel(const SField& field, int x, int y, int channel) {
+            x = (x % SIZE + SIZE) % SIZE;
+            y = (y % SIZE + SIZE) % SIZE;
+            return field.texels[(static_cast<size_t>(y) * SIZE + x) * 2 + channel];
+        }
+
+    } // namespace
+
+    SField generate(uint32_t seed) {
+        SField field;
+        field.seed = seed;
+        field.texels.resize(static_cast<size_t>(SIZE) * SIZE * 2);
+
+        // Decorrelated streams for the two offset axes
+        const uint32_t seedX = hash(seed);
+        const uint32_t seedY = hash(seed ^ 0x9e3779b9U);
+
+        for (int y = 0; y < SIZE; ++y) {
+            for (int x = 0; x < SIZE; ++x) {
+                const size_t i       = (static_cast<size_t>(y) * SIZE + x) * 2;
+                field.texels[i]      = valueNoise(x, y, seedX);
+                field.texels[i + 1]  = valueNoise(x, y, seedY);
+            }
+        }
+
+        return field;
+    }
+
+    void SField::sample(float u, float v, float& outX, float& outY) const {
+        const float x  = u * SIZE - 0.5f;
+        const float y  = v * SIZE - 0.5f;
+        const float x0 = std::floor(x), y0 = std::floor(y);
+        const float fx = x - x0, fy = y - y0;
+        const int   ix = static_cast<int>(x0), iy = static_cast<int>(y0);
+
+        float       out[2];
+        for (int c = 0; c < 2; ++c) {
+            const float top    = texel(*this, ix, iy, c) * (1.f - fx) + texel(*this, ix + 1, iy, c) * fx;
+            const float bottom = texel(*this, ix, iy + 1, c) * (1.f - fx) + texel(*this, ix + 1, iy + 1, c) * fx;
+            out[c]             = (top * (1.f - fy) + bottom * fy) / 255.f;
+        }
+
+        outX = out[0];
+        outY = out[1];
+    }
+}
@@ -0,0 +1,70 @@
+#include "framestats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // {"p50": .., "p99": .., "max": .., "histogram": [[upper bound, count], ...]}
+    std::string summarize(std::vector<uint64_t>& values) {
+        if (values.empty())
+            return R"({"p50": 0, "p99": 0, "max": 0, "histogram": []})";
+
+        std::sort(values.begin(), values.end());
+        const auto percentile = [&](double p) { return values[static_cast<size_t>(p * (values.size() - 1))]; };
+
+        // Power of two buckets, value v lands in the bucket with upper bound bit_ceil(v + 1)
+        std::array<uint64_t, 65> buckets{};
+        for (uint64_t v : values)
+            buckets[std::bit_width(v)]++;
+
+        std::string histogram;
+        for (size_t i = 0; i < buckets.size(); ++i) {
+            if (!buckets[i])
+                continue;
+            if (!histogram.empty())
+                histogram += ", ";
+            histogram += "[" + std::to_string(i >= 64 ? UINT64_MAX : (uint64_t{1} << i)) + ", " + std::to_string(buckets[i]) + "]";
+        }
+
+        return R"({"p50": )" + std::to_string(percentile(0.5)) + R"(, "p99": )" + std::to_string(percentile(0.99)) + R"(, "max": )" +
+            std::to_string(values.back()) + R"(, "histogram": [)" + histogram + "]}";
+    }
+
+} // namespace
+
+void CFrameStats::endFrame() {
+    // Frames where no window went through the plugin would only dilute the percentiles
+    if (m_current.windows) {
+        m_ring[m_published % CAPACITY] = m_current;
+        m_published++;
+    }
+
+    m_current = {};
+}
+
+void CFrameStats::reset() {
+    m_resetAt = m_published;
+}
+
+std::string CFrameStats::json() const {
+    const uint64_t published = m_published;
+    const uint64_t first     = std::max(m_resetAt, published > CAPACITY ? published - CAPACITY : 0);
+
+    std::vector<uint64_t> callback, maxCallback, ruleMatch, windows, glassWindows, plannedPasses;
+    for (uint64_t i = first; i < published; ++i) {
+        const auto& frame = m_ring[i % CAPACITY];
+        callback.push_back(frame.callbackNs);
+        maxCallback.push_back(frame.maxCallbackNs);
+        ruleMatch.push_back(frame.ruleMatchNs);
+        windows.push_back(frame.windows);
+        glassWindows.push_back(frame.glassWindows);
+        plannedPasses.push_back(frame.plannedPasses);
+    }
+
+    return std::string(R"({"enabled": )") + (enabled() ? "true" : "false") + R"(, "frames": )" + std::to_string(published - first) +
+        R"(, "callback_ns": )" + summarize(callback) + R"(, "max_callback_ns": )" + summarize(maxCallback) + R"(, "rule_match_ns": )" + summarize(ruleMatch) +
+        R"(, "windows": )" + summarize(windows) + R"(, "glass_windows": )" + summarize(glassWindows) + R"(, "planned_passes": )" + summarize(plannedPasses) + "}";
+}
@@ -1,8 +1,21 @@
 #include <HyprlandAPI.hpp>
-#include <regex>
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <vector>
 #include <string>
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "backdropbatch.hpp"
+#include "backdropcache.hpp"
+#include "blur.hpp"
+#include "configsnapshot.hpp"
+#include "framestats.hpp"
+#include "governor.hpp"
+#include "gputimer.hpp"
+#include "shadercache.hpp"
 
 class CGlassWindow {
   public:
@@ -14,6 +27,7 @@ class CGlassWindow {
     // Called once on plugin init
     void init(HANDLE pluginHandle) {
         m_pluginHandle = pluginHandle;
+        m_gpuTimer.init();
         registerConfig();
         reloadConfig();
 
@@ -24,6 +38,33 @@ class CGlassWindow {
         // Register config reload hook (optional)
         HyprlandAPI::registerCallback(m_pluginHandle, "configReload", 
             [this](void*) { this->reloadConfig(); });
+
+        // Rule decisions are cached per window, drop them when the title/class
+        // they were made for goes away
+        HyprlandAPI::registerCallback(m_pluginHandle, "windowTitle",
+            [this](void* data) { m_ruleDecisions.erase(data); });
+        HyprlandAPI::registerCallback(m_pluginHandle, "windowClass",
+            [this](void* data) { m_ruleDecisions.erase(data); });
+        HyprlandAPI::registerCallback(m_pluginHandle, "closeWindow",
+            [this](void* data) {
+                m_ruleDecisions.erase(data);
+                m_backdropCache.invalidate(data);
+            });
+
+        // Cached backdrops are only valid for what was behind the window when
+        // they were made. Moves/resizes are caught by the box check in the cache.
+        HyprlandAPI::registerCallback(m_pluginHandle, "moveWindow",
+            [this](void* data) { m_backdropCache.invalidate(data); });
+        HyprlandAPI::registerCallback(m_pluginHandle, "workspace",
+            [this](void*) { m_backdropCache.invalidateAll(); });
+
+        // Frame boundary for the hot path stats and the quality governor
+        HyprlandAPI::registerCallback(m_pluginHandle, "preRender",
+            [this](void* data) { this->onPreRender(data); });
+
+        // `hyprctl glasswindow stats` dumps the hot path stats as JSON, `hyprctl glasswindow reset` clears them
+        HyprlandAPI::registerHyprCtlCommand(m_pluginHandle, "glasswindow",
+            [this](const std::string& args) { return this->onHyprCtl(args); });
     }
 
     // Called once on plugin exit
@@ -31,22 +72,96 @@ class CGlassWindow {
         // Unregister all hooks
         HyprlandAPI::unregisterCallback(m_pluginHandle, "renderWindow");
         HyprlandAPI::unregisterCallback(m_pluginHandle, "configReload");
+        HyprlandAPI::unregisterCallback(m_pluginHandle, "windowTitle");
+        HyprlandAPI::unregisterCallback(m_pluginHandle, "windowClass");
+        HyprlandAPI::unregisterCallback(m_pluginHandle, "closeWindow");
+        HyprlandAPI::unregisterCallback(m_pluginHandle, "moveWindow");
+        HyprlandAPI::unregisterCallback(m_pluginHandle, "workspace");
+        HyprlandAPI::unregisterCallback(m_pluginHandle, "preRender");
+        HyprlandAPI::unregisterHyprCtlCommand(m_pluginHandle, "glasswindow");
+
+        m_ruleDecisions.clear();
+        m_backdropCache.invalidateAll();
+        m_glassWindows.clear();
+        m_distortion = {};
 
-        // TODO: free shaders/resources here
+        m_config.store(nullptr, std::memory_order_release);
+        m_snapshot.reset();
+        m_retiredSnapshot.reset();
+
+        m_shaders.destroy();
+        m_gpuTimer.destroy();
+        if (m_distortionTex) {
+            glDeleteTextures(1, &m_distortionTex);
+            m_distortionTex = 0;
+        }
+    }
+
+    // Hit/partial/miss counters of the per-window backdrop cache
+    const CBackdropCache::SStats& backdropCacheStats() const {
+        return m_backdropCache.stats();
     }
 
   private:
     HANDLE m_pluginHandle = nullptr;
 
-    // Config keys (strings, floats, ints)
-    std::string m_rulesRaw;             // Raw regex/rule strings from config
-    std::vector<std::regex> m_rules;   // Parsed regex rules
+    // Compiled config, see configsnapshot.hpp. The render path loads
+    // m_config once per callback and only reads through it. Reload swaps in a
+    // new snapshot; the one it replaces is kept alive until the next reload,
+    // so a reader still holding it never sees it freed.
+    std::atomic<const NConfig::SSnapshot*> m_config{nullptr};
+    std::unique_ptr<const NConfig::SSnapshot> m_snapshot;        // Owns *m_config
+    std::unique_ptr<const NConfig::SSnapshot> m_retiredSnapshot; // The previous one
+
+    // Memoized profileForWindow() result per window handle, -1 = no glass.
+    // An entry stands for the window's class/title at the time it was made,
+    // so it is erased on title/class change and the whole map is cleared on
+    // config reload.
+    std::unordered_map<void*, int> m_ruleDecisions;
+
+    // Distortion field sampled by glass.frag, regenerated on reload
+    NDistortion::SField m_distortion;
 
-    float m_strength = 0.7f;            // Glass effect strength (blur etc)
-    float m_chromaticAberration = 0.f; // Chromatic aberration strength
-    float m_opacity = 0.9f;             // Opacity of glass effect
+    // Blurred backdrop kept per window across frames, see backdropcache.hpp
+    CBackdropCache m_backdropCache;
+    std::vector<SRect> m_redoRects;     // Reused every frame, no per-frame allocation
 
-    // TODO: shader program handles
+    // Batched mode (plugin:glasswindow:batch): the glass windows of each
+    // monitor share one blur of the union of their backdrops. The windows
+    // rendered last frame decide what this frame's shared blur covers, a
+    // window that is new or moved since falls back to its own blur once.
+    // The shared blur is kept across frames in m_backdropCache under the
+    // monitor's key, so only damage gets blurred again, as for one window.
+    struct SMonitorBatch {
+        CBackdropBatch shared;          // Last frame's glass windows
+        CBackdropBatch next;            // Glass windows rendered this frame
+        bool blurred = false;           // Shared blur already done this frame
+    };
+    std::unordered_map<void*, SMonitorBatch> m_glassWindows; // Keyed by monitor
+    // Hyprland renders one monitor at a time, starting with its preRender, so
+    // the windows rendered after it are on that monitor. Keying both sides by
+    // this pointer keeps render and preRender on the same batch.
+    void* m_renderMonitor = nullptr;
+    uint64_t m_sharedBlurs = 0;         // Shared blurs planned, no shared framebuffer is drawn yet
+    uint64_t m_batchFallbacks = 0;      // Windows the shared blur didn't cover
+
+    // Compiled shader variants, every one the config and governor can pick is prebuilt
+    CShaderCache m_shaders;
+    GLuint m_distortionTex = 0;         // m_distortion uploaded as GL_RG8
+
+    // Hot path instrumentation, off unless plugin:glasswindow:stats is set
+    CFrameStats m_stats;
+
+    // Drops effect quality when the plugin eats too much of the frame
+    // budget. It is fed the larger of the plugin's CPU time and, where the
+    // driver has timer queries, the GPU time of the glass passes. CPU time
+    // alone misses a GPU that can't keep up.
+    CQualityGovernor m_governor;
+    CGpuTimer m_gpuTimer;
+    uint64_t m_frameCostNs = 0;         // Plugin CPU time since the last preRender
+
+    // Stats or governor need the render callback timed
+    bool m_timed = false;
 
     CGlassWindow() = default;
     ~CGlassWindow() = default;
@@ -57,68 +172,313 @@ class CGlassWindow {
         // Register your config keys here with default values
         HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:rules", ".*");
         HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:strength", "0.7");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:blur_step", "0.01");
         HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:chromatic_aberration", "0.0");
         HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:opacity", "0.9");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:distortion_seed", "0");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:batch", "0");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:stats", "0");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:governor", "1");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:governor_degrade_at", "0.25");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:governor_restore_at", "0.1");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:governor_degrade_frames", "3");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:governor_restore_frames", "60");
+        HyprlandAPI::addConfigValue(m_pluginHandle, "plugin:glasswindow:governor_tiny_area", "40000");
     }
 
     void reloadConfig() {
-        m_rulesRaw = HyprlandAPI::getConfigValue(m_pluginHandle, "plugin:glasswindow:rules");
-        m_strength = std::stof(HyprlandAPI::getConfigValue(m_pluginHandle, "plugin:glasswindow:strength"));
-        m_chromaticAberration = std::stof(HyprlandAPI::getConfigValue(m_pluginHandle, "plugin:glasswindow:chromatic_aberration"));
-        m_opacity = std::stof(HyprlandAPI::getConfigValue(m_pluginHandle, "plugin:glasswindow:opacity"));
+        const auto* previous = m_config.load(std::memory_order_relaxed);
 
-        parseRules(m_rulesRaw);
+        std::vector<std::string> errors;
+        auto snapshot = NConfig::compile([this](const std::string& key) { return HyprlandAPI::getConfigValue(m_pluginHandle, key); },
+            previous ? previous->generation + 1 : 1, errors);
 
-        // TODO: update shader uniforms here
-    }
+        for (const auto& error : errors) {
+            HyprlandAPI::addNotification(m_pluginHandle, "glasswindow", error, "error", 5000);
+        }
 
-    void parseRules(const std::string& rulesRaw) {
-        m_rules.clear();
+        // A value that doesn't parse keeps the config that was running
+        if (!snapshot)
+            return;
 
-        // Assume rulesRaw is a semicolon-separated list of regex patterns
-        size_t start = 0;
-        while (true) {
-            size_t end = rulesRaw.find(';', start);
-            std::string rule = rulesRaw.substr(start, (end == std::string::npos ? rulesRaw.size() : end) - start);
+        m_retiredSnapshot = std::move(m_snapshot);
+        m_snapshot = std::move(snapshot);
+        m_config.store(m_snapshot.get(), std::memory_order_release);
 
-            try {
-                m_rules.emplace_back(rule, std::regex::ECMAScript | std::regex::icase);
-            } catch (const std::regex_error& e) {
-                HyprlandAPI::addNotification(m_pluginHandle, "glasswindow", 
-                    "Invalid regex in rules: " + rule, "error", 5000);
-            }
+        const auto& config = *m_snapshot;
+
+        m_stats.setEnabled(config.stats);
+        m_governor.setConfig(config.governor);
+        m_gpuTimer.setEnabled(m_governor.enabled());
+        m_frameCostNs = 0;
 
-            if (end == std::string::npos) break;
-            start = end + 1;
+        m_timed = m_stats.enabled() || m_governor.enabled();
+
+        // The field only depends on the seed, skip the work if it didn't change
+        if (m_distortion.texels.empty() || m_distortion.seed != config.distortionSeed) {
+            m_distortion = NDistortion::generate(config.distortionSeed);
+            uploadDistortion();
         }
+
+        // Decisions and blurs were made with the old rules and profiles
+        m_ruleDecisions.clear();
+        m_backdropCache.invalidateAll();
+        m_glassWindows.clear();
+
+        buildShaders(config);
     }
 
-    bool shouldApplyToWindow(const std::string& windowTitle) {
-        for (const auto& rule : m_rules) {
-            if (std::regex_search(windowTitle, rule)) {
-                return true;
+    // Build every program the current config draws with, up front, so the
+    // render path never compiles anything
+    void buildShaders(const NConfig::SSnapshot& config) {
+        // Profiles and levels share most variants, report each broken one once
+        std::unordered_set<uint32_t> failed;
+
+        for (const auto& profile : config.profiles) {
+            for (int level = 0; level < CQualityGovernor::QUALITY_LEVELS; ++level) {
+                for (bool focused : {true, false}) {
+                    const auto params = CQualityGovernor::paramsAt(profile.params, static_cast<CQualityGovernor::eLevel>(level), focused, false);
+
+                    for (const auto& variant : NShaders::variantsFor(params)) {
+                        if (failed.contains(variant.key()))
+                            continue;
+
+                        std::string error;
+                        if (!m_shaders.build(variant, &error)) {
+                            failed.insert(variant.key());
+                            HyprlandAPI::addNotification(m_pluginHandle, "glasswindow", 
+                                "Failed to build shader: " + error, "error", 5000);
+                        }
+                    }
+                }
             }
         }
-        return false;
     }
 
-    void applyGlassEffect(void* window) {
-        // TODO: Implement your shader or blur effect here, using m_strength, m_chromaticAberration, m_opacity
+    void uploadDistortion() {
+        if (!m_distortionTex)
+            glGenTextures(1, &m_distortionTex);
+
+        glBindTexture(GL_TEXTURE_2D, m_distortionTex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG8, NDistortion::SIZE, NDistortion::SIZE, 0, GL_RG, GL_UNSIGNED_BYTE, m_distortion.texels.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    // Index into config.profiles of the first rule matching the window, -1 if none does
+    int profileForWindow(const NConfig::SSnapshot& config, void* window) {
+        if (auto it = m_ruleDecisions.find(window); it != m_ruleDecisions.end())
+            return it->second;
+
+        const int profile = config.profileFor(getWindowTitleFromData(window));
+        m_ruleDecisions.emplace(window, profile);
+        return profile;
+    }
+
+    // Returns the number of GPU passes the effect needs. The draws are still
+    // placeholders, so this is planned work, nothing is issued yet.
+    int applyGlassEffect(const NConfig::SSnapshot& config, int profileIndex, void* window) {
+        // TODO: Implement your shader or blur effect here, using the window's profile
+        //
+        // The blur is a dual-Kawase chain (see blur.hpp): NBlur::planBlur(params, w, h)
+        // gives the pass count, then blur_down.frag runs `passes` times into half-size
+        // framebuffers, blur_up.frag walks back up to the half-size level, and glass.frag
+        // does the last upsample together with distortion, chromatic and alpha.
+
+        const auto& profile = config.profiles[profileIndex];
+        const SRect box = getWindowBoxFromData(window);
+        const auto  params = m_governor.paramsFor(profile.params, isWindowFocused(window), box.area());
+
+        // Prebuilt in reloadConfig(), a miss here means it failed to compile
+        const SGlassProgram* program = m_shaders.get(NShaders::glassVariant(params));
+        if (!program)
+            return 0;
+
+        const auto plan = NBlur::planBlur(params, box.w, box.h);
+
+        // Everything up to end() is GPU time the governor gets to see
+        m_gpuTimer.begin();
+
+        const int passes = 1 + blurBackdrop(config, window, box, plan); // + glass.frag
+
+        // Placeholder, the profile's uniforms go in with one call:
+        // glUniform4fv(program->profile, 1, &profile.block.strength);
+        // HyprlandAPI::drawCustomEffect(window, program);
+
+        m_gpuTimer.end();
+        return passes;
+    }
+
+    // Plans the blur of what is behind `window`, shared or from its own cache. Returns the passes it needs.
+    int blurBackdrop(const NConfig::SSnapshot& config, void* window, const SRect& box, const NBlur::SBlurPlan& plan) {
+        if (plan.passes == 0)
+            return 0;
 
-        // Placeholder:
-        // HyprlandAPI::drawCustomEffect(window, m_strength, m_chromaticAberration, m_opacity);
+        if (config.batch) {
+            if (int shared = blurShared(config, window, box); shared >= 0)
+                return shared;
+        }
+
+        // Only the damaged parts of the cached backdrop get blurred again. The
+        // cache keeps no framebuffer yet, its hits and misses are what the
+        // re-blur would do.
+        if (m_backdropCache.update(window, box, getFrameDamageFromData(window), NBlur::footprint(plan), m_redoRects) == CBackdropCache::CACHE_HIT)
+            return 0;
+
+        // TODO: run the blur chain scissored to m_redoRects into the window's cached framebuffer
+        return 2 * plan.passes - 1;
+    }
+
+    // Batched mode: plans the monitor's shared blur if this is its first glass
+    // window this frame. Returns the passes it needs, or -1 when the shared
+    // blur doesn't cover `window` and it needs a blur of its own.
+    int blurShared(const NConfig::SSnapshot& config, void* window, const SRect& box) {
+        // Nothing to share before the first preRender
+        if (!m_renderMonitor)
+            return -1;
+
+        auto& batch = m_glassWindows[m_renderMonitor];
+        batch.next.addWindow(window, box);
+
+        if (!batch.shared.covers(window, box)) {
+            m_batchFallbacks++;
+            return -1;
+        }
+
+        // The window's own backdrop misses the damage of the frames it is
+        // covered, it can't be reused once the window falls back
+        m_backdropCache.invalidate(window);
+
+        if (batch.blurred)
+            return 0;
+        batch.blurred = true;
+
+        // One plan for the whole batch, sized for its biggest window and the
+        // widest profile so every window gets at least the reach it asked for
+        const SRect largest = batch.shared.largest();
+        const auto  plan    = NBlur::planBlur(m_governor.paramsFor(config.batchParams, true, largest.area()), largest.w, largest.h);
+        if (plan.passes == 0)
+            return 0;
+
+        const int   radius = NBlur::footprint(plan);
+        const auto& region = batch.shared.region(radius, getMonitorBoxFromData(m_renderMonitor));
+        if (region.empty())
+            return 0;
+
+        // A changed region is a miss, like a window's changed box
+        if (m_backdropCache.update(m_renderMonitor, CBackdropBatch::bounds(region), getMonitorDamageFromData(m_renderMonitor), radius, m_redoRects) ==
+            CBackdropCache::CACHE_HIT)
+            return 0;
+        m_sharedBlurs++;
+
+        // TODO: run the blur chain once, scissored to m_redoRects within `region`, into the monitor's shared framebuffer.
+        // glass.frag then samples it for every window in the batch with that window's own
+        // strength, chromatic and alpha, masked to the window's shape.
+        return 2 * plan.passes - 1;
     }
 
     void onRenderWindow(void* data) {
         // `data` usually points to a structure describing the window being rendered, e.g. CWindow*
 
-        // Extract window title (pseudo-code)
-        std::string windowTitle = getWindowTitleFromData(data);
+        // With stats and governor off this branch is all the instrumentation costs
+        if (m_timed) [[unlikely]] {
+            onRenderWindowInstrumented(data);
+            return;
+        }
+
+        const auto* config = m_config.load(std::memory_order_acquire);
+        if (!config)
+            return;
+
+        if (const int profile = profileForWindow(*config, data); profile >= 0)
+            applyGlassEffect(*config, profile, data);
+    }
+
+    void onRenderWindowInstrumented(void* data) {
+        using Clock = std::chrono::steady_clock;
+        const auto ns = [](Clock::duration d) { return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()); };
+
+        const auto* config = m_config.load(std::memory_order_acquire);
+        if (!config)
+            return;
+
+        const auto start = Clock::now();
 
-        if (!shouldApplyToWindow(windowTitle))
+        // Governor only needs the total, skip the extra clock read
+        if (!m_stats.enabled()) {
+            if (const int profile = profileForWindow(*config, data); profile >= 0)
+                applyGlassEffect(*config, profile, data);
+            m_frameCostNs += ns(Clock::now() - start);
             return;
+        }
+
+        const int  profile = profileForWindow(*config, data);
+        const bool apply = profile >= 0;
+        const auto matched = Clock::now();
+        const int  passes = apply ? applyGlassEffect(*config, profile, data) : 0;
+        const auto end = Clock::now();
+
+        m_frameCostNs += ns(end - start);
 
-        applyGlassEffect(data);
+        auto& frame = m_stats.current();
+        frame.callbackNs += ns(end - start);
+        frame.maxCallbackNs = std::max(frame.maxCallbackNs, ns(end - start));
+        frame.ruleMatchNs += ns(matched - start);
+        frame.windows++;
+        frame.glassWindows += apply;
+        frame.plannedPasses += passes;
+    }
+
+    void onPreRender(void* monitor) {
+        m_renderMonitor = monitor;
+
+        // Cost is attributed per preRender, on multi-monitor setups that's the
+        // previous monitor's frame checked against this one's budget. GPU
+        // time arrives a few frames late, until then only CPU time counts.
+        if (m_governor.enabled()) {
+            const auto budgetNs = static_cast<uint64_t>(1e9 / getMonitorRefreshRateFromData(monitor));
+
+            uint64_t   gpuNs = 0;
+            m_gpuTimer.endFrame(gpuNs);
+
+            // Cached blurs were made at the old quality
+            if (m_governor.onFrame(std::max(m_frameCostNs, gpuNs), budgetNs))
+                m_backdropCache.invalidateAll();
+        }
+        m_frameCostNs = 0;
+
+        // What was rendered last frame is what this frame's shared blur covers
+        if (const auto* config = m_config.load(std::memory_order_acquire); config && config->batch) {
+            auto& batch = m_glassWindows[monitor];
+            std::swap(batch.shared, batch.next);
+            batch.next.clear();
+            batch.blurred = false;
+        }
+
+        if (m_stats.enabled())
+            m_stats.endFrame();
+    }
+
+    std::string onHyprCtl(const std::string& args) {
+        if (args == "reset") {
+            m_stats.reset();
+            m_backdropCache.resetStats();
+            m_sharedBlurs    = 0;
+            m_batchFallbacks = 0;
+            return "ok";
+        }
+
+        if (!args.empty() && args != "stats")
+            return "error: unknown argument '" + args + "', expected stats or reset";
+
+        const auto* config = m_config.load(std::memory_order_acquire);
+        const auto& cache = m_backdropCache.stats();
+        return R"({"frames": )" + m_stats.json() + R"(, "config_generation": )" + std::to_string(config ? config->generation : 0) + R"(, "quality_level": )" + std::to_string(m_governor.level()) + R"(, "governor_clock": )" + (m_gpuTimer.supported() ? R"("cpu+gpu")" : R"("cpu")") + R"(, "planned": {"backdrop_cache": {"hits": )" + std::to_string(cache.hits) + R"(, "partials": )" +
+            std::to_string(cache.partials) + R"(, "misses": )" + std::to_string(cache.misses) + R"(}, "batch": {"shared_blurs": )" + std::to_string(m_sharedBlurs) + R"(, "fallbacks": )" + std::to_string(m_batchFallbacks) + "}}}";
     }
 
     // Dummy placeholder for getting window title from `data`
@@ -126,6 +486,42 @@ class CGlassWindow {
         // TODO: Use actual Hyprland API to get window title string
         return "ExampleWindowTitle";
     }
+
+    // Dummy placeholder for getting the window box from `data`
+    SRect getWindowBoxFromData(void* data) {
+        // TODO: Use actual Hyprland API to get the window position and size
+        return {0, 0, 800, 600};
+    }
+
+    // Dummy placeholder for checking whether the window in `data` has focus
+    bool isWindowFocused(void* data) {
+        // TODO: Use actual Hyprland API to compare against the focused window
+        return true;
+    }
+
+    // Dummy placeholder for getting the refresh rate of the monitor in `data`
+    float getMonitorRefreshRateFromData(void* data) {
+        // TODO: Use actual Hyprland API to get the monitor refresh rate
+        return 60.f;
+    }
+
+    // Dummy placeholder for getting the area of the monitor in `data`
+    SRect getMonitorBoxFromData(void* data) {
+        // TODO: Use actual Hyprland API to get the monitor position and size
+        return {0, 0, 1920, 1080};
+    }
+
+    // Dummy placeholder for getting this frame's damage over the window
+    std::span<const SRect> getFrameDamageFromData(void* data) {
+        // TODO: Use actual Hyprland API to get the damage region rects
+        return {};
+    }
+
+    // Dummy placeholder for getting this frame's damage on the monitor in `data`
+    std::span<const SRect> getMonitorDamageFromData(void* data) {
+        // TODO: Use actual Hyprland API to get the monitor's damage region rects
+        return {};
+    }
 };
 
 extern "C" {
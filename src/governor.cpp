@@ -0,0 +1,89 @@
+#include "governor.hpp"
+
+#include <algorithm>
+
+void CQualityGovernor::setConfig(const SConfig& config) {
+    m_config = config;
+    reset();
+}
+
+void CQualityGovernor::reset() {
+    m_level    = QUALITY_FULL;
+    m_share    = 0.0;
+    m_overRun  = 0;
+    m_underRun = 0;
+    m_settleLeft = 0;
+    m_settleSum  = 0.0;
+    m_restoreBackoff = 1;
+    m_probeLeft      = 0;
+}
+
+void CQualityGovernor::step(int direction) {
+    if (direction > 0 && m_probeLeft > 0)
+        m_restoreBackoff = std::min(m_restoreBackoff * 2, std::max(m_config.maxRestoreBackoff, 1));
+    m_probeLeft = direction < 0 ? m_config.restoreFrames : 0;
+
+    m_level    = static_cast<eLevel>(m_level + direction);
+    m_overRun  = 0;
+    m_underRun = 0;
+
+    // The average still holds the old level's cost, start it over from
+    // what this level actually costs
+    m_settleLeft = std::max(m_config.settleFrames, 1);
+    m_settleSum  = 0.0;
+}
+
+bool CQualityGovernor::onFrame(uint64_t costNs, uint64_t budgetNs) {
+    if (!m_config.enabled || !budgetNs)
+        return false;
+
+    const double share = static_cast<double>(costNs) / budgetNs;
+
+    if (m_settleLeft > 0) {
+        m_settleSum += share;
+        if (--m_settleLeft == 0)
+            m_share = m_settleSum / std::max(m_config.settleFrames, 1);
+        return false;
+    }
+
+    m_share += (share - m_share) * m_config.smoothing;
+
+    // The last restore held, the load it came back from is gone
+    if (m_probeLeft > 0 && --m_probeLeft == 0)
+        m_restoreBackoff = 1;
+
+    // Anything between the two thresholds breaks both runs, that gap is the hysteresis
+    m_overRun  = m_share > m_config.degradeAt ? m_overRun + 1 : 0;
+    m_underRun = m_share < m_config.restoreAt ? m_underRun + 1 : 0;
+
+    if (m_overRun >= m_config.degradeFrames && m_level + 1 < QUALITY_LEVELS) {
+        step(1);
+        return true;
+    }
+
+    if (m_underRun >= m_config.restoreFrames * m_restoreBackoff && m_level > QUALITY_FULL) {
+        step(-1);
+        return true;
+    }
+
+    return false;
+}
+
+NBlur::SGlassParams CQualityGovernor::paramsAt(const NBlur::SGlassParams& base, eLevel level, bool focused, bool tiny) {
+    NBlur::SGlassParams params = base;
+    if (level == QUALITY_FULL)
+        return params;
+
+    if (level >= QUALITY_ALPHA || tiny || (level >= QUALITY_FOCUSED_ONLY && !focused)) {
+        params.strength = 0.f;
+        return params;
+    }
+
+    params.up_taps    = NBlur::UP_TAPS_CHEAP;
+    params.distortion = false;
+
+    if (level >= QUALITY_NO_CHROMATIC)
+        params.chromatic = false;
+
+    return params;
+}
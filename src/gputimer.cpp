@@ -0,0 +1,110 @@
+#include "gputimer.hpp"
+
+#include <EGL/egl.h>
+
+#include <cstring>
+
+void CGpuTimer::init() {
+    destroy();
+
+    const auto* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (!extensions || !std::strstr(extensions, "GL_EXT_disjoint_timer_query"))
+        return;
+
+    m_genQueries          = reinterpret_cast<PFNGLGENQUERIESEXTPROC>(eglGetProcAddress("glGenQueriesEXT"));
+    m_deleteQueries       = reinterpret_cast<PFNGLDELETEQUERIESEXTPROC>(eglGetProcAddress("glDeleteQueriesEXT"));
+    m_beginQuery          = reinterpret_cast<PFNGLBEGINQUERYEXTPROC>(eglGetProcAddress("glBeginQueryEXT"));
+    m_endQuery            = reinterpret_cast<PFNGLENDQUERYEXTPROC>(eglGetProcAddress("glEndQueryEXT"));
+    m_getQueryObjectuiv   = reinterpret_cast<PFNGLGETQUERYOBJECTUIVEXTPROC>(eglGetProcAddress("glGetQueryObjectuivEXT"));
+    m_getQueryObjectui64v = reinterpret_cast<PFNGLGETQUERYOBJECTUI64VEXTPROC>(eglGetProcAddress("glGetQueryObjectui64vEXT"));
+
+    if (!m_genQueries || !m_deleteQueries || !m_beginQuery || !m_endQuery || !m_getQueryObjectuiv || !m_getQueryObjectui64v)
+        return;
+
+    for (auto& frame : m_frames)
+        m_genQueries(QUERIES_PER_FRAME, frame.queries.data());
+
+    // Clear a disjoint event left over from before, it would void the first results
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+
+    m_supported = true;
+}
+
+void CGpuTimer::destroy() {
+    if (m_supported) {
+        if (m_open)
+            m_endQuery(GL_TIME_ELAPSED_EXT);
+        for (auto& frame : m_frames)
+            m_deleteQueries(QUERIES_PER_FRAME, frame.queries.data());
+    }
+
+    m_frames    = {};
+    m_current   = 0;
+    m_supported = false;
+    m_open      = false;
+}
+
+void CGpuTimer::begin() {
+    auto& frame = m_frames[m_current];
+
+    // A slot still waiting for the GPU can't be reused, this frame goes unmeasured
+    if (!m_supported || !m_enabled || m_open || frame.pending || frame.used == QUERIES_PER_FRAME)
+        return;
+
+    m_beginQuery(GL_TIME_ELAPSED_EXT, frame.queries[frame.used]);
+    m_open = true;
+}
+
+void CGpuTimer::end() {
+    if (!m_open)
+        return;
+
+    m_endQuery(GL_TIME_ELAPSED_EXT);
+    m_frames[m_current].used++;
+    m_open = false;
+}
+
+bool CGpuTimer::endFrame(uint64_t& gpuNs) {
+    if (!m_supported)
+        return false;
+
+    end();
+
+    auto& frame   = m_frames[m_current];
+    frame.pending = frame.used > 0;
+
+    // The slot the next frame records into is the oldest one in flight
+    m_current = (m_current + 1) % FRAMES_IN_FLIGHT;
+    return collect(m_frames[m_current], gpuNs);
+}
+
+bool CGpuTimer::collect(SFrame& frame, uint64_t& gpuNs) {
+    if (!frame.pending)
+        return false;
+
+    // Queries finish in order, the last one being ready means all are
+    GLuint available = 0;
+    m_getQueryObjectuiv(frame.queries[frame.used - 1], GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+    if (!available)
+        return false;
+
+    uint64_t total = 0;
+    for (size_t i = 0; i < frame.used; ++i) {
+        GLuint64 ns = 0;
+        m_getQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT_EXT, &ns);
+        total += ns;
+    }
+
+    frame.used    = 0;
+    frame.pending = false;
+
+    // A disjoint event (clock change, GPU reset) makes the results meaningless
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    if (disjoint)
+        return false;
+
+    gpuNs = total;
+    return true;
+}
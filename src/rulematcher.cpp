@@ -0,0 +1,292 @@
+#include "rulematcher.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+// ASCII only, std::tolower goes through the locale on every call
+char lower(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+bool iequals(std::string_view a, std::string_view lowered) {
+    return a.size() == lowered.size() && std::equal(a.begin(), a.end(), lowered.begin(), [](char x, char y) { return lower(x) == y; });
+}
+
+// An empty needle is in every title, the empty one included
+bool icontains(std::string_view haystack, std::string_view lowered) {
+    return lowered.empty() || std::search(haystack.begin(), haystack.end(), lowered.begin(), lowered.end(), [](char x, char y) { return lower(x) == y; }) != haystack.end();
+}
+
+bool isQuantifier(char c) {
+    return c == '?' || c == '*' || c == '+' || c == '{';
+}
+
+// \1..\9 refer to groups by number, which shifts once the rule is part of
+// the combined alternation
+bool hasBackreference(std::string_view rule) {
+    for (size_t i = 0; i + 1 < rule.size(); ++i) {
+        if (rule[i] != '\\')
+            continue;
+        if (rule[i + 1] >= '1' && rule[i + 1] <= '9')
+            return true;
+        ++i;
+    }
+    return false;
+}
+
+// Position of the ] closing the class opened at `open`, npos if there is
+// none. A class starting with ] or ^] is npos too, engines disagree on those.
+size_t classEnd(std::string_view rule, size_t open) {
+    size_t i = open + 1;
+    if (i < rule.size() && rule[i] == '^')
+        ++i;
+    if (i < rule.size() && rule[i] == ']')
+        return std::string_view::npos;
+    while (i < rule.size() && rule[i] != ']')
+        i += rule[i] == '\\' ? 2 : 1;
+    return i < rule.size() ? i : std::string_view::npos;
+}
+
+} // namespace
+
+std::optional<CRuleMatcher::SLiteralRule> CRuleMatcher::asLiteral(std::string_view rule) {
+    SLiteralRule literal;
+
+    const bool   start = !rule.empty() && rule.front() == '^';
+    const bool   end   = rule.size() > (start ? 1u : 0u) && rule.back() == '$';
+    if (start)
+        rule.remove_prefix(1);
+    if (end)
+        rule.remove_suffix(1);
+
+    // Anything with regex syntax left in it goes through std::regex
+    if (rule.find_first_of(".^$|()[]{}*+?\\") != std::string_view::npos)
+        return std::nullopt;
+
+    literal.text.reserve(rule.size());
+    for (char c : rule)
+        literal.text += lower(c);
+
+    literal.anchor = start && end ? eLiteralAnchor::FULL : start ? eLiteralAnchor::START : end ? eLiteralAnchor::END : eLiteralAnchor::NONE;
+    return literal;
+}
+
+std::string CRuleMatcher::requiredLiteral(std::string_view rule) {
+    // Conservative: only runs of plain characters at the top level count, and
+    // a top level alternation means nothing is required at all. Brackets
+    // and bars inside classes or escaped don't count.
+    int depth = 0;
+    for (size_t i = 0; i < rule.size(); ++i) {
+        if (rule[i] == '\\')
+            ++i;
+        else if (rule[i] == '[') {
+            if ((i = classEnd(rule, i)) == std::string_view::npos)
+                return {};
+        } else if (rule[i] == '(')
+            ++depth;
+        else if (rule[i] == ')')
+            --depth;
+        else if (rule[i] == '|' && depth == 0)
+            return {};
+    }
+
+    std::string best, run;
+    const auto  flush = [&] {
+        if (run.size() > best.size())
+            best = run;
+        run.clear();
+    };
+
+    depth = 0;
+    for (size_t i = 0; i < rule.size(); ++i) {
+        char c = rule[i];
+
+        if (c == '[') {
+            if ((i = classEnd(rule, i)) == std::string_view::npos)
+                return {};
+            flush();
+            continue;
+        }
+
+        if (c == '{') {
+            while (i < rule.size() && rule[i] != '}')
+                ++i;
+            flush();
+            continue;
+        }
+
+        if (c == '(' || c == ')') {
+            depth += c == '(' ? 1 : -1;
+            flush();
+            continue;
+        }
+
+        if (c == '\\') {
+            // \xHH \uHHHH \cX spell a character with the text after them,
+            // which would otherwise be taken as literal text
+            if (i + 1 < rule.size() && (rule[i + 1] == 'x' || rule[i + 1] == 'u' || rule[i + 1] == 'c'))
+                return {};
+
+            // Escaped punctuation is a literal, \d \w \b and friends are not
+            if (i + 1 >= rule.size() || std::isalnum(static_cast<unsigned char>(rule[i + 1]))) {
+                ++i;
+                flush();
+                continue;
+            }
+            c = rule[++i];
+        } else if (std::string_view(".^$*+?|}").find(c) != std::string_view::npos) {
+            flush();
+            continue;
+        }
+
+        if (depth > 0) {
+            flush();
+            continue;
+        }
+
+        // x? x* x{..} make x optional, x+ keeps it but ends the run, unless
+        // another quantifier follows: libstdc++ takes x+* and x+?? too, and
+        // those are optional again. A single ? after + only makes it lazy.
+        const char next = i + 1 < rule.size() ? rule[i + 1] : '\0';
+        size_t     after = i + 2;
+        if (after < rule.size() && rule[after] == '?')
+            ++after;
+        if ((isQuantifier(next) && next != '+') || (next == '+' && after < rule.size() && isQuantifier(rule[after]))) {
+            flush();
+            continue;
+        }
+
+        run += lower(c);
+        if (next == '+')
+            flush();
+    }
+
+    flush();
+    return best;
+}
+
+void CRuleMatcher::compile(const std::string& rulesRaw, std::vector<std::string>* invalidRules) {
+    m_matchAll      = false;
+    m_matchAllIndex = std::string::npos;
+    m_ruleCount     = 0;
+    m_literals.clear();
+    m_regexes.clear();
+    m_unneedled.clear();
+    m_combined.reset();
+
+    std::string combined;
+
+    size_t      start = 0;
+    for (size_t index = 0;; ++index) {
+        size_t      end  = rulesRaw.find(';', start);
+        std::string rule = rulesRaw.substr(start, (end == std::string::npos ? rulesRaw.size() : end) - start);
+
+        if (rule.empty() || rule == ".*") {
+            if (!m_matchAll)
+                m_matchAllIndex = index;
+            m_matchAll = true;
+            m_ruleCount++;
+        } else if (auto literal = asLiteral(rule)) {
+            literal->index = index;
+            m_literals.emplace_back(std::move(*literal));
+            m_ruleCount++;
+        } else {
+            // Validate on its own first so one bad rule doesn't take the
+            // combined matcher down with it
+            try {
+                std::regex re(rule, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+                if (auto needle = requiredLiteral(rule); !needle.empty() || hasBackreference(rule))
+                    m_regexes.push_back({std::move(needle), std::move(re), index});
+                else {
+                    if (!combined.empty())
+                        combined += '|';
+                    combined += "(?:" + rule + ")";
+                    m_unneedled.push_back({{}, std::move(re), index});
+                }
+                m_ruleCount++;
+            } catch (const std::regex_error&) {
+                if (invalidRules)
+                    invalidRules->emplace_back(rule);
+            }
+        }
+
+        if (end == std::string::npos)
+            break;
+        start = end + 1;
+    }
+
+    if (!combined.empty() && !m_matchAll)
+        m_combined.emplace(combined, std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+}
+
+bool CRuleMatcher::literalMatches(const SLiteralRule& rule, std::string_view title) {
+    const auto& text = rule.text;
+    if (text.size() > title.size())
+        return false;
+
+    switch (rule.anchor) {
+        case eLiteralAnchor::FULL: return iequals(title, text);
+        case eLiteralAnchor::START: return iequals(title.substr(0, text.size()), text);
+        case eLiteralAnchor::END: return iequals(title.substr(title.size() - text.size()), text);
+        case eLiteralAnchor::NONE: break;
+    }
+
+    return icontains(title, text);
+}
+
+bool CRuleMatcher::matches(std::string_view title) const {
+    if (m_matchAll)
+        return true;
+
+    for (const auto& literal : m_literals) {
+        if (literalMatches(literal, title))
+            return true;
+    }
+
+    for (const auto& rule : m_regexes) {
+        if (icontains(title, rule.needle) && std::regex_search(title.begin(), title.end(), rule.re))
+            return true;
+    }
+
+    return m_combined && std::regex_search(title.begin(), title.end(), *m_combined);
+}
+
+int CRuleMatcher::firstMatch(std::string_view title) const {
+    // Each list is in rule order, so only its first match counts, and nothing
+    // at or after the best position so far needs checking
+    size_t best = m_matchAllIndex;
+
+    for (const auto& literal : m_literals) {
+        if (literal.index >= best)
+            break;
+        if (literalMatches(literal, title)) {
+            best = literal.index;
+            break;
+        }
+    }
+
+    for (const auto& rule : m_regexes) {
+        if (rule.index >= best)
+            break;
+        if (icontains(title, rule.needle) && std::regex_search(title.begin(), title.end(), rule.re)) {
+            best = rule.index;
+            break;
+        }
+    }
+
+    // The alternation rules out the common no-match case in one search
+    if (!m_unneedled.empty() && m_unneedled.front().index < best && (!m_combined || std::regex_search(title.begin(), title.end(), *m_combined))) {
+        for (const auto& rule : m_unneedled) {
+            if (rule.index >= best)
+                break;
+            if (std::regex_search(title.begin(), title.end(), rule.re)) {
+                best = rule.index;
+                break;
+            }
+        }
+    }
+
+    return best == std::string::npos ? -1 : static_cast<int>(best);
+}
@@ -0,0 +1,100 @@
+#include "shadercache.hpp"
+
+namespace {
+
+    GLuint compileShader(GLenum type, const char* source, std::string* error) {
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+
+        GLint ok = GL_FALSE;
+        glGetShaderiv(shader, GL_COMPILE_STATUS, &ok);
+        if (ok == GL_TRUE)
+            return shader;
+
+        if (error) {
+            GLint length = 0;
+            glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &length);
+            error->resize(length > 0 ? length : 0);
+            GLsizei written = 0; // the length above counts the terminating NUL
+            glGetShaderInfoLog(shader, length, &written, error->data());
+            error->resize(written);
+        }
+
+        glDeleteShader(shader);
+        return 0;
+    }
+
+} // namespace
+
+const SGlassProgram* CShaderCache::build(const NShaders::SVariant& variant, std::string* error) {
+    if (auto it = m_programs.find(variant.key()); it != m_programs.end())
+        return &it->second;
+
+    const std::string fragSource = NShaders::fragmentSource(variant);
+
+    GLuint            vert = compileShader(GL_VERTEX_SHADER, NShaders::vertexSource(), error);
+    if (!vert)
+        return nullptr;
+
+    GLuint frag = compileShader(GL_FRAGMENT_SHADER, fragSource.c_str(), error);
+    if (!frag) {
+        glDeleteShader(vert);
+        return nullptr;
+    }
+
+    SGlassProgram program;
+    program.id = glCreateProgram();
+    glAttachShader(program.id, vert);
+    glAttachShader(program.id, frag);
+    glLinkProgram(program.id);
+
+    // The program keeps what it needs, the shader objects can go
+    glDetachShader(program.id, vert);
+    glDetachShader(program.id, frag);
+    glDeleteShader(vert);
+    glDeleteShader(frag);
+
+    GLint ok = GL_FALSE;
+    glGetProgramiv(program.id, GL_LINK_STATUS, &ok);
+    if (ok != GL_TRUE) {
+        if (error) {
+            GLint length = 0;
+            glGetProgramiv(program.id, GL_INFO_LOG_LENGTH, &length);
+            error->resize(length > 0 ? length : 0);
+            GLsizei written = 0; // the length above counts the terminating NUL
+            glGetProgramInfoLog(program.id, length, &written, error->data());
+            error->resize(written);
+        }
+        glDeleteProgram(program.id);
+        return nullptr;
+    }
+
+    program.proj              = glGetUniformLocation(program.id, "proj");
+    program.posAttrib         = glGetAttribLocation(program.id, "pos");
+    program.texAttrib         = glGetAttribLocation(program.id, "texcoord");
+    program.tex               = glGetUniformLocation(program.id, "tex");
+    program.profile           = glGetUniformLocation(program.id, "profile");
+    program.resolution        = glGetUniformLocation(program.id, "resolution");
+    program.blurTex           = glGetUniformLocation(program.id, "blurTex");
+    program.blurTexel         = glGetUniformLocation(program.id, "blurTexel");
+    program.blurOffset        = glGetUniformLocation(program.id, "blurOffset");
+    program.distortionTex     = glGetUniformLocation(program.id, "distortionTex");
+    program.texel             = glGetUniformLocation(program.id, "texel");
+    program.offset            = glGetUniformLocation(program.id, "offset");
+
+    return &m_programs.emplace(variant.key(), program).first->second;
+}
+
+const SGlassProgram* CShaderCache::get(const NShaders::SVariant& variant) const {
+    if (auto it = m_programs.find(variant.key()); it != m_programs.end())
+        return &it->second;
+    return nullptr;
+}
+
+void CShaderCache::destroy() {
+    for (auto& [key, program] : m_programs) {
+        glDeleteProgram(program.id);
+    }
+    m_programs.clear();
+}
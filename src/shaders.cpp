@@ -0,0 +1,66 @@
+#include "shaders.hpp"
+
+#include "shadersources.hpp"
+
+namespace NShaders {
+
+    uint32_t SVariant::key() const {
+        return static_cast<uint32_t>(program) | (blur << 4) | (distortion << 5) | (chromatic << 6) | (alphaOnly << 7) | (static_cast<uint32_t>(upTaps) << 8);
+    }
+
+    SVariant glassVariant(const NBlur::SGlassParams& params) {
+        SVariant variant;
+
+        if (params.strength <= 0.f) {
+            variant.alphaOnly = true;
+            return variant;
+        }
+
+        variant.blur       = params.blur_step > 0.f;
+        variant.distortion = variant.blur && params.distortion;
+        variant.chromatic  = params.chromatic;
+        variant.upTaps     = variant.blur ? params.up_taps : 0;
+        return variant;
+    }
+
+    std::vector<SVariant> variantsFor(const NBlur::SGlassParams& params) {
+        std::vector<SVariant> variants = {glassVariant(params)};
+
+        if (variants.front().blur) {
+            variants.push_back({.program = PROGRAM_BLUR_DOWN});
+            variants.push_back({.program = PROGRAM_BLUR_UP, .upTaps = static_cast<uint8_t>(params.up_taps)});
+        }
+
+        return variants;
+    }
+
+    std::string fragmentSource(const SVariant& variant) {
+        std::string source;
+        switch (variant.program) {
+            case PROGRAM_GLASS: source = SHADER_GLASS_FRAG; break;
+            case PROGRAM_BLUR_DOWN: source = SHADER_BLUR_DOWN_FRAG; break;
+            case PROGRAM_BLUR_UP: source = SHADER_BLUR_UP_FRAG; break;
+        }
+
+        std::string defines;
+        if (variant.blur)
+            defines += "#define BLUR\n";
+        if (variant.distortion)
+            defines += "#define DISTORTION\n";
+        if (variant.chromatic)
+            defines += "#define CHROMATIC\n";
+        if (variant.alphaOnly)
+            defines += "#define ALPHA_ONLY\n";
+        if (variant.upTaps)
+            defines += "#define UP_TAPS " + std::to_string(variant.upTaps) + "\n";
+
+        // Defines have to come after the #version line
+        const size_t afterVersion = source.find('\n') + 1;
+        source.insert(afterVersion, defines);
+        return source;
+    }
+
+    const char* vertexSource() {
+        return SHADER_GLASS_VERT;
+    }
+}